@@ -0,0 +1,56 @@
+#include "catModel.hpp"
+#include "heightMapGenerator.hpp"
+#include "jsonDeserializer.hpp"
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+const CatModel &CatModel::get() {
+  static const CatModel model;
+  return model;
+}
+
+std::filesystem::path
+CatModel::dataPath(const std::filesystem::path &relative) {
+  return std::filesystem::path(ARMCADILLO_DATA_DIR) / relative;
+}
+
+CatModel::CatModel() {
+  const JsonDeserializer deserializer;
+  deserializer.loadScence(dataPath("model/proper_cat.json").string(), scene_);
+
+  std::vector<BezierSurface *> surfaces;
+  for (auto *entity : scene_.getEntites()) {
+    if (auto *surface = dynamic_cast<BezierSurface *>(entity)) {
+      surfaces.push_back(surface);
+    }
+  }
+  model_ = std::make_unique<Model>(surfaces);
+
+  heightMap_ = std::make_unique<HeightMap>(
+      HeightMapGenerator().generateHeightMap(*model_, block_));
+}
+
+const BezierSurface &CatModel::surface(std::string_view name) const {
+  for (const auto *surface : model_->surfaces()) {
+    if (surface->getName() == name) {
+      return *surface;
+    }
+  }
+  throw std::runtime_error("No surface named " + std::string(name));
+}
+
+const Intersection &CatModel::intersection() const {
+  if (!intersection_) {
+    IntersectionFinder finder;
+    finder.setSurfaces(&surface("tulow"), &surface("glowa"));
+    auto intersection = finder.find(false);
+    if (!intersection) {
+      throw std::runtime_error("Body and head of the cat do not intersect");
+    }
+    intersection_ = std::make_unique<Intersection>(std::move(*intersection));
+  }
+  return *intersection_;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "bezierSurface.hpp"
+#include "block.hpp"
+#include "heightMap.hpp"
+#include "intersectionFinder.hpp"
+#include "model.hpp"
+#include "scene.hpp"
+#include <filesystem>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+/// data/model/proper_cat.json loaded once per process and shared by all
+/// benchmarks, so fixtures do not count towards the measured kernels.
+class CatModel {
+public:
+  static const CatModel &get();
+  static std::filesystem::path dataPath(const std::filesystem::path &relative);
+
+  const Model &model() const { return *model_; }
+  const Block &block() const { return block_; }
+  const HeightMap &heightMap() const { return *heightMap_; }
+  const BezierSurface &surface(std::string_view name) const;
+
+  /// body and head, traced once on first use
+  const Intersection &intersection() const;
+
+private:
+  CatModel();
+
+  Scene scene_{nullptr};
+  std::unique_ptr<Model> model_;
+  Block block_ = Block::defaultBlock();
+  std::unique_ptr<HeightMap> heightMap_;
+  mutable std::unique_ptr<Intersection> intersection_;
+};
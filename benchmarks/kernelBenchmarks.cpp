@@ -0,0 +1,167 @@
+#include "GCodeSerializer.hpp"
+#include "catModel.hpp"
+#include "cutter.hpp"
+#include "functions.hpp"
+#include "intersectionTexture.hpp"
+#include "millingPath.hpp"
+#include "newtonMethod.hpp"
+#include "normalOffsetSurface.hpp"
+#include "pathReader.hpp"
+#include "rdp.hpp"
+#include "vec.hpp"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+/// Micro benchmarks of the kernels path generation and intersection tracing
+/// spend their time in, fed with the cat model and the shipped paths.
+
+namespace {
+
+constexpr uint32_t kGridSize = 64;
+
+std::vector<algebra::Vec2f> parameterGrid(const BezierSurface &surface) {
+  const auto bounds = surface.bounds();
+  std::vector<algebra::Vec2f> grid;
+  grid.reserve(kGridSize * kGridSize);
+  for (uint32_t i = 0; i < kGridSize; ++i) {
+    for (uint32_t j = 0; j < kGridSize; ++j) {
+      const float s = static_cast<float>(i) / (kGridSize - 1);
+      const float t = static_cast<float>(j) / (kGridSize - 1);
+      grid.emplace_back(bounds[0][0] + s * (bounds[0][1] - bounds[0][0]),
+                        bounds[1][0] + t * (bounds[1][1] - bounds[1][0]));
+    }
+  }
+  return grid;
+}
+
+Cutter ballCutter(float diameter) {
+  return Cutter{
+      .type_ = Cutter::Type::Ball, .diameter_ = diameter, .height_ = 4.f};
+}
+
+void BM_BezierSurfaceC0Value(benchmark::State &state) {
+  const auto &surface = CatModel::get().surface("tulow");
+  const auto &algebra_surface = surface.getAlgebraSurfaceC0();
+  const auto grid = parameterGrid(surface);
+
+  for (auto _ : state) {
+    for (const auto &uv : grid) {
+      benchmark::DoNotOptimize(algebra_surface.value(uv));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * grid.size());
+}
+BENCHMARK(BM_BezierSurfaceC0Value);
+
+void BM_NormalOffsetSurfaceDerivatives(benchmark::State &state) {
+  const auto &surface = CatModel::get().surface("tulow");
+  const algebra::NormalOffsetSurface offset_surface(
+      &surface.getAlgebraSurfaceC0(), 0.4f);
+  const auto grid = parameterGrid(surface);
+
+  for (auto _ : state) {
+    for (const auto &uv : grid) {
+      benchmark::DoNotOptimize(offset_surface.derivatives(uv));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * grid.size());
+}
+BENCHMARK(BM_NormalOffsetSurfaceDerivatives);
+
+/// refines a point of the traced body/head curve moved off the curve
+void BM_NewtonMethod(benchmark::State &state) {
+  const auto &cat = CatModel::get();
+  const auto &points = cat.intersection().points;
+  const auto &point = points[points.size() / 2];
+  const algebra::Vec4f start{point.surface0[0] + 0.01f,
+                             point.surface0[1] - 0.01f,
+                             point.surface1[0] + 0.01f,
+                             point.surface1[1] - 0.01f};
+
+  for (auto _ : state) {
+    algebra::NewtonMethod<4, 4> newton(
+        std::make_unique<algebra::IntersectionFunction>(&cat.surface("tulow"),
+                                                        &cat.surface("glowa")),
+        start);
+    benchmark::DoNotOptimize(newton.calculate());
+  }
+}
+BENCHMARK(BM_NewtonMethod);
+
+/// argument is the cutter diameter in millimetres
+void BM_FindMinimumSafeHeightForCut(benchmark::State &state) {
+  const auto &height_map = CatModel::get().heightMap();
+  const auto cutter = ballCutter(static_cast<float>(state.range(0)) / 10.f);
+  const auto &divisions = height_map.divisions();
+  const uint32_t pixels = divisions.x_ * divisions.z_;
+  constexpr uint32_t kStride = 997;
+
+  for (auto _ : state) {
+    for (uint32_t index = 0; index < pixels; index += kStride) {
+      benchmark::DoNotOptimize(
+          height_map.findMinimumSafeHeightForCut(index, cutter));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * (pixels / kStride));
+}
+BENCHMARK(BM_FindMinimumSafeHeightForCut)->Arg(8)->Arg(16);
+
+void BM_RDPReducePoints(benchmark::State &state) {
+  const auto points =
+      MillingPathReader::readPoints(CatModel::dataPath("paths/3.k08"));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(algebra::RDP::reducePoints(points, 0.001f));
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+BENCHMARK(BM_RDPReducePoints);
+
+/// fills the body texture outside the body/head curve
+void BM_IntersectionTextureFloodFill(benchmark::State &state) {
+  const auto &cat = CatModel::get();
+  const auto &body = cat.surface("tulow");
+  const auto &head = cat.surface("glowa");
+  auto [texture, unused] = IntersectionTexture::createIntersectionTextures(
+      cat.intersection(), {body.bounds(), head.bounds()});
+
+  for (auto _ : state) {
+    texture->floodFill(0, 0, true);
+  }
+  const auto size = texture->getSize();
+  state.SetItemsProcessed(state.iterations() * size.width * size.height);
+}
+BENCHMARK(BM_IntersectionTextureFloodFill)->Unit(benchmark::kMillisecond);
+
+void BM_GCodeRead(benchmark::State &state) {
+  const auto file = CatModel::dataPath("paths/3.k08");
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(MillingPathReader::readPoints(file));
+  }
+  state.SetBytesProcessed(state.iterations() *
+                          std::filesystem::file_size(file));
+}
+BENCHMARK(BM_GCodeRead)->Unit(benchmark::kMillisecond);
+
+/// argument 1 fits arcs
+void BM_GCodeWrite(benchmark::State &state) {
+  const MillingPath path(
+      MillingPathReader::readPoints(CatModel::dataPath("paths/3.k08")),
+      ballCutter(0.8f));
+  const GCodeDialect dialect{.arcs_ = state.range(0) != 0};
+  const auto file =
+      std::filesystem::temp_directory_path() / "armcadillo_bench.k08";
+
+  for (auto _ : state) {
+    GCodeSerializer::serializePath(path, file, dialect);
+  }
+  state.SetItemsProcessed(state.iterations() * path.points().size());
+  std::filesystem::remove(file);
+}
+BENCHMARK(BM_GCodeWrite)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,55 @@
+#include "catModel.hpp"
+#include "cutter.hpp"
+#include "heightMapGenerator.hpp"
+#include "intersectionFinder.hpp"
+#include "roughingPathGenerator.hpp"
+#include <benchmark/benchmark.h>
+
+/// Whole stages on the cat model. Run with few repetitions, every one takes
+/// from hundreds of milliseconds to seconds.
+
+namespace {
+
+void BM_HeightMapGeneration(benchmark::State &state) {
+  const auto &cat = CatModel::get();
+  HeightMapGenerator generator;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        generator.generateHeightMap(cat.model(), cat.block()));
+  }
+}
+BENCHMARK(BM_HeightMapGeneration)->Unit(benchmark::kMillisecond);
+
+void BM_RoughingPath(benchmark::State &state) {
+  const auto &cat = CatModel::get();
+  const Cutter cutter{
+      .type_ = Cutter::Type::Ball, .diameter_ = 1.6f, .height_ = 3.2f};
+  RoughingPathGenerator generator;
+  generator.setHeightMap(&cat.heightMap());
+  generator.setCutter(&cutter);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(generator.generate());
+  }
+}
+BENCHMARK(BM_RoughingPath)->Unit(benchmark::kMillisecond);
+
+/// the first point is found stochastically, expect some spread
+void BM_IntersectionTracing(benchmark::State &state) {
+  const auto &cat = CatModel::get();
+  IntersectionFinder finder;
+  finder.setSurfaces(&cat.surface("tulow"), &cat.surface("glowa"));
+
+  for (auto _ : state) {
+    const auto intersection = finder.find(false);
+    if (!intersection) {
+      state.SkipWithError("no intersection found");
+      break;
+    }
+    benchmark::DoNotOptimize(intersection->points.data());
+  }
+}
+BENCHMARK(BM_IntersectionTracing)->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -2,6 +2,7 @@
 
 #include "../functions.hpp"
 #include "../vec.hpp"
+#include "progress.hpp"
 #include <cstddef>
 #include <memory>
 #include <print>
@@ -23,6 +24,8 @@ public:
   void setStartingPoint(const Vec<float, SIZE> &startingPoint) {
     startingPoint_ = startingPoint;
   }
+  /// calculate() throws Cancelled once the context gets cancelled
+  void setProgress(const ProgressContext *progress) { progress_ = progress; }
 
   std::optional<Vec<float, SIZE>> calculate() {
     auto arg = startingPoint_;
@@ -30,6 +33,9 @@ public:
     auto val = function_->value(arg);
 
     for (int i = 0; i < iterationCount_; ++i) {
+      if (progress_ != nullptr && i % kPollInterval == 0) {
+        progress_->throwIfCancelled();
+      }
       auto newArg = arg - learningRate_ * function_->gradient(arg);
 
       for (size_t dim = 0; dim < SIZE; ++dim) {
@@ -90,6 +96,8 @@ private:
   float learningRate_ = 0.001f;
   Vec<float, SIZE> startingPoint_;
   std::unique_ptr<IDifferentiableScalarFunction<SIZE>> function_;
+  const ProgressContext *progress_ = nullptr;
+  static constexpr int kPollInterval = 64;
 
   float paramDistSquared(const algebra::Vec2f &a, const algebra::Vec2f &b) {
     float du = std::fabs(a[0] - b[0]);
@@ -3,6 +3,7 @@
 #include "../functions.hpp"
 #include "../vec.hpp"
 #include "linearSystem.hpp"
+#include "progress.hpp"
 #include <cstddef>
 #include <memory>
 #include <print>
@@ -17,11 +18,17 @@ public:
       : function_(std::move(function)), currentPoint(startingPoint) {}
 
   void setIterationCount(size_t iterations) { iterationCount_ = iterations; }
+  /// calculate() throws Cancelled once the context gets cancelled, checked
+  /// every iteration since each one solves a linear system
+  void setProgress(const ProgressContext *progress) { progress_ = progress; }
   std::optional<Vec4f> calculate() {
     auto arg = currentPoint;
     auto bounds = function_->bounds();
 
     for (size_t i = 0; i < iterationCount_; ++i) {
+      if (progress_ != nullptr) {
+        progress_->throwIfCancelled();
+      }
       auto jacobian = function_->jacobian(arg);
       auto valueVec = -1.0f * function_->value(arg);
       auto deltaOpt = LinearSystem::solveLinearSystem(jacobian, valueVec);
@@ -79,6 +86,7 @@ private:
 
   Vec4f currentPoint;
   size_t iterationCount_ = 40;
+  const ProgressContext *progress_ = nullptr;
   static constexpr float kAccuracy = 10e-6;
 };
 } // namespace algebra
\ No newline at end of file
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+
+namespace algebra {
+
+class Cancelled : public std::runtime_error {
+public:
+  Cancelled() : std::runtime_error("Cancelled") {}
+};
+
+/// Progress and cancellation of a long computation, shared with whoever
+/// watches it. Routines take a nullable pointer and poll it between
+/// iterations, a poll is a couple of relaxed atomic operations.
+///
+/// A child context covers `weight` of its parent and shares its
+/// cancellation, so parts of one job running concurrently report through
+/// children of their own. One context is reported to by one thread at a
+/// time, reading it is safe from any thread.
+class ProgressContext {
+public:
+  ProgressContext() : cancelled_(&cancelledFlag_) { restart(); }
+  ProgressContext(ProgressContext &parent, float weight)
+      : parent_(&parent), weight_(weight), cancelled_(parent.cancelled_) {
+    restart();
+  }
+
+  ProgressContext(const ProgressContext &) = delete;
+  ProgressContext &operator=(const ProgressContext &) = delete;
+
+  void cancel() { cancelled_->store(true, std::memory_order_relaxed); }
+  bool cancelled() const {
+    return cancelled_->load(std::memory_order_relaxed);
+  }
+  void throwIfCancelled() const {
+    if (cancelled()) {
+      throw Cancelled();
+    }
+  }
+
+  /// fraction of this context's work done, in [0, 1]
+  void report(float fraction) {
+    fraction = std::clamp(fraction, 0.f, 1.f);
+    const float delta = fraction - reported_;
+    reported_ = fraction;
+    advance(delta);
+  }
+  /// report and throwIfCancelled
+  void poll(float fraction) {
+    report(fraction);
+    throwIfCancelled();
+  }
+
+  float fraction() const { return done_.load(std::memory_order_relaxed); }
+
+  /// elapsed time extrapolated linearly, nullopt before any progress
+  std::optional<double> remainingSeconds() const {
+    const float done = fraction();
+    if (done <= 0.f) {
+      return std::nullopt;
+    }
+    const auto elapsed = std::chrono::duration<double>(
+        Clock::now().time_since_epoch() -
+        Clock::duration(start_.load(std::memory_order_relaxed)));
+    return elapsed.count() * (1.0 - done) / done;
+  }
+
+  /// remaining time is measured from here, e.g. when a queued job starts
+  void restart() {
+    start_.store(Clock::now().time_since_epoch().count(),
+                 std::memory_order_relaxed);
+  }
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  ProgressContext *parent_ = nullptr;
+  float weight_ = 1.f;
+  float reported_ = 0.f;
+  std::atomic<float> done_ = 0.f;
+  std::atomic<bool> cancelledFlag_ = false;
+  std::atomic<bool> *cancelled_;
+  std::atomic<Clock::rep> start_ = 0;
+
+  void advance(float delta) {
+    done_.fetch_add(delta, std::memory_order_relaxed);
+    if (parent_ != nullptr) {
+      parent_->advance(delta * weight_);
+    }
+  }
+};
+
+} // namespace algebra
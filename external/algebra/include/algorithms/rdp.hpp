@@ -4,7 +4,10 @@
 #include "../vec.hpp"
 #include <algorithm>
 #include <cstddef>
-#include <iterator>
+#include <cstdint>
+#include <future>
+#include <optional>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -12,77 +15,149 @@ namespace algebra {
 
 class RDP {
 public:
+  /// distances measured after projecting onto plane
   static std::vector<Vec3f> reducePoints(const std::vector<Vec3f> &points,
                                          float eps, Plane plane) {
-    if (points.size() < 2) {
-      return points;
+    return reduce(points, eps, plane);
+  }
+
+  /// true 3D distances
+  static std::vector<Vec3f> reducePoints(const std::vector<Vec3f> &points,
+                                         float eps) {
+    return reduce(points, eps, std::nullopt);
+  }
+
+  /// mask[i] != 0 when points[i] survives the reduction. Paths longer than
+  /// kChunkSize are split at fixed anchor points and the chunks are reduced
+  /// concurrently.
+  static std::vector<uint8_t> keepMask(std::span<const Vec3f> points,
+                                       float eps,
+                                       std::optional<Plane> plane) {
+    std::vector<uint8_t> mask(points.size(), 0);
+    if (points.empty()) {
+      return mask;
+    }
+
+    mask.front() = 1;
+    mask.back() = 1;
+
+    if (points.size() <= kChunkSize) {
+      reduceRange(points, 0, points.size() - 1, eps, plane, mask);
+      return mask;
     }
 
-    return rdpRecursion(points, 0, points.size() - 1, eps, plane);
+    std::vector<std::future<void>> chunks;
+    for (size_t start = 0; start < points.size() - 1; start += kChunkSize) {
+      const size_t end = std::min(start + kChunkSize, points.size() - 1);
+      mask[end] = 1;
+      chunks.push_back(std::async(std::launch::async, [=, &mask] {
+        reduceRange(points, start, end, eps, plane, mask);
+      }));
+    }
+
+    for (auto &chunk : chunks) {
+      chunk.get();
+    }
+    return mask;
   }
 
 private:
-  static std::vector<Vec3f> rdpRecursion(const std::vector<Vec3f> &points,
-                                         size_t start, size_t end, float eps,
-                                         Plane plane) {
-    const auto &first = points[start];
-    const auto &last = points[end];
-
-    if (end - start < 2) {
-      if (end - start == 0) {
-        return {first};
-      }
-      return {first, last};
+  static constexpr size_t kChunkSize = 1 << 14;
+
+  static std::vector<Vec3f> reduce(const std::vector<Vec3f> &points, float eps,
+                                   std::optional<Plane> plane) {
+    if (points.size() < 3) {
+      return points;
     }
 
-    auto project = [plane](const Vec3f &p) -> Vec2f {
-      switch (plane) {
-      case Plane::XY:
-        return {p.x(), p.y()};
-      case Plane::XZ:
-        return {p.x(), p.z()};
-      case Plane::YZ:
-        return {p.y(), p.z()};
+    const auto mask = keepMask(points, eps, plane);
+
+    std::vector<Vec3f> result;
+    result.reserve(static_cast<size_t>(std::ranges::count(mask, 1)));
+    for (size_t i = 0; i < points.size(); ++i) {
+      if (mask[i] != 0) {
+        result.push_back(points[i]);
       }
+    }
+    return result;
+  }
 
-      std::unreachable();
-    };
-
-    auto distance_from_segment = [&project](const Vec3f &p, const Vec3f &a,
-                                            const Vec3f &b) {
-      auto p_projected = project(p);
-      auto a_projected = project(a);
-      auto b_projected = project(b);
-      auto ab = b_projected - a_projected;
-      auto ap = p_projected - a_projected;
-      auto t = std::clamp(ap.dot(ab) / ab.dot(ab), 0.f, 1.f);
-      auto closest = a_projected + t * ab;
-      return (closest - p_projected).length();
-    };
-
-    auto furthest_point =
-        std::max_element(points.begin() + start + 1, points.begin() + end,
-                         [&](const Vec3f &p, const Vec3f &q) {
-                           return distance_from_segment(p, first, last) <
-                                  distance_from_segment(q, first, last);
-                         });
-
-    float max_distance = distance_from_segment(*furthest_point, first, last);
-
-    if (max_distance < eps) {
-      return {first, last};
+  /// Marks points strictly between start and end, endpoints belong to the
+  /// caller.
+  static void reduceRange(std::span<const Vec3f> points, size_t start,
+                          size_t end, float eps, std::optional<Plane> plane,
+                          std::span<uint8_t> mask) {
+    if (!plane) {
+      reduceRange(points, start, end, eps, mask,
+                  [](const Vec3f &p) { return p; });
+      return;
     }
 
-    size_t furthest_index = std::distance(points.begin(), furthest_point);
-    auto first_part = rdpRecursion(points, start, furthest_index, eps, plane);
-    auto second_part = rdpRecursion(points, furthest_index, end, eps, plane);
+    switch (*plane) {
+    case Plane::XY:
+      reduceRange(points, start, end, eps, mask,
+                  [](const Vec3f &p) { return Vec2f{p.x(), p.y()}; });
+      return;
+    case Plane::XZ:
+      reduceRange(points, start, end, eps, mask,
+                  [](const Vec3f &p) { return Vec2f{p.x(), p.z()}; });
+      return;
+    case Plane::YZ:
+      reduceRange(points, start, end, eps, mask,
+                  [](const Vec3f &p) { return Vec2f{p.y(), p.z()}; });
+      return;
+    }
 
-    std::vector<Vec3f> result;
-    result.reserve(first_part.size() + second_part.size());
-    result.insert(result.end(), first_part.begin(), first_part.end() - 1);
-    result.insert(result.end(), second_part.begin(), second_part.end());
+    std::unreachable();
+  }
 
-    return result;
+  template <typename Project>
+  static void reduceRange(std::span<const Vec3f> points, size_t start,
+                          size_t end, float eps, std::span<uint8_t> mask,
+                          Project project) {
+    const float eps_squared = eps * eps;
+
+    /// explicit stack of [first, last] ranges, depth bounded by recursion
+    /// depth of the classic formulation
+    std::vector<std::pair<size_t, size_t>> ranges;
+    ranges.reserve(64);
+    ranges.emplace_back(start, end);
+
+    while (!ranges.empty()) {
+      const auto [first, last] = ranges.back();
+      ranges.pop_back();
+
+      if (last - first < 2) {
+        continue;
+      }
+
+      const auto a = project(points[first]);
+      const auto ab = project(points[last]) - a;
+      const auto ab_squared = ab.dot(ab);
+
+      float max_distance_squared = -1.f;
+      size_t furthest = first;
+      for (size_t i = first + 1; i < last; ++i) {
+        const auto ap = project(points[i]) - a;
+        const float t =
+            ab_squared > 0.f ? std::clamp(ap.dot(ab) / ab_squared, 0.f, 1.f)
+                             : 0.f;
+        const auto diff = ap - ab * t;
+        const float distance_squared = diff.dot(diff);
+        if (distance_squared > max_distance_squared) {
+          max_distance_squared = distance_squared;
+          furthest = i;
+        }
+      }
+
+      if (max_distance_squared < eps_squared) {
+        continue;
+      }
+
+      mask[furthest] = 1;
+      ranges.emplace_back(first, furthest);
+      ranges.emplace_back(furthest, last);
+    }
   }
 };
 
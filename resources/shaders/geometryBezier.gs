@@ -2,8 +2,10 @@
 layout(points) in;
 layout(line_strip, max_vertices = 256) out;
 
-uniform mat4 view;
-uniform mat4 projection;
+layout(std140, binding = 0) uniform Camera {
+  mat4 view;
+  mat4 projection;
+};
 uniform bool renderPolyLine;
 uniform int screenResolution;
 
@@ -2,12 +2,56 @@
 
 layout(vertices = 20) out;
 
+layout(std140, binding = 0) uniform Camera {
+  mat4 view;
+  mat4 projection;
+};
 uniform uint u_subdivisions;
 uniform uint v_subdivisions;
-uniform uint direction;
+in uint vs_instance[];
+patch out uint direction;
+// viewport size in pixels
+uniform vec2 viewport;
+// largest distance in pixels between a segment and the curve it replaces
+uniform float pixel_error;
+
+const float max_level = 64.0;
+// isolines closer than this many pixels are merged
+const float min_line_spacing = 4.0;
+
+// the patch lies in the convex hull of its control points
+bool outside_frustum(vec4 c[20]) {
+  for (int axis = 0; axis < 3; ++axis) {
+    bool below = true;
+    bool above = true;
+    for (int i = 0; i < 20; ++i) {
+      below = below && c[i][axis] < -c[i].w;
+      above = above && c[i][axis] > c[i].w;
+    }
+    if (below || above) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// segments keeping a cubic within pixel_error of its polyline, bounded by
+// its second differences
+float segments(vec2 b0, vec2 b1, vec2 b2, vec2 b3) {
+  float second = max(length(b0 - 2.0 * b1 + b2), length(b1 - 2.0 * b2 + b3));
+  return ceil(sqrt(0.75 * second / pixel_error));
+}
+
+float polyline_length(vec2 b0, vec2 b1, vec2 b2, vec2 b3) {
+  return length(b1 - b0) + length(b2 - b1) + length(b3 - b2);
+}
 
 void main() {
   gl_out[gl_InvocationID].gl_Position = gl_in[gl_InvocationID].gl_Position;
+  if (gl_InvocationID != 0) {
+    return;
+  }
+  direction = vs_instance[0];
 
   uint u_sub = u_subdivisions;
   uint v_sub = v_subdivisions + 1;
@@ -19,13 +63,68 @@ void main() {
   }
 
   u_sub++;
-  if (gl_InvocationID == 0) {
+  gl_TessLevelInner[0] = v_sub;
+  gl_TessLevelInner[1] = u_sub;
+
+  vec4 c[20];
+  bool behind = false;
+  for (int i = 0; i < 20; ++i) {
+    c[i] = projection * view * gl_in[i].gl_Position;
+    behind = behind || c[i].w <= 0.0;
+  }
+
+  if (outside_frustum(c)) {
+    gl_TessLevelOuter[0] = 0.0;
+    gl_TessLevelOuter[1] = 0.0;
+    return;
+  }
+
+  // screen positions are meaningless across the eye plane, keep the user set
+  // density there
+  if (behind) {
     gl_TessLevelOuter[0] = u_sub;
     gl_TessLevelOuter[1] = v_sub;
     gl_TessLevelOuter[2] = u_sub;
     gl_TessLevelOuter[3] = v_sub;
+    return;
+  }
 
-    gl_TessLevelInner[0] = v_sub;
-    gl_TessLevelInner[1] = u_sub;
+  vec2 s[20];
+  for (int i = 0; i < 20; ++i) {
+    s[i] = 0.5 * c[i].xy / c[i].w * viewport;
   }
-}
\ No newline at end of file
+
+  // 4x4 net the evaluation shader blends, interior points averaged
+  vec2 net[16] = vec2[16](
+      s[0], s[1], s[2], s[3],
+      s[4], 0.5 * (s[12] + s[16]), 0.5 * (s[15] + s[19]), s[5],
+      s[6], 0.5 * (s[13] + s[17]), 0.5 * (s[14] + s[18]), s[7],
+      s[8], s[9], s[10], s[11]);
+
+  // direction 0 draws lines along u, the first net index
+  float along = 1.0;
+  float across = 0.0;
+  for (int k = 0; k < 4; ++k) {
+    if (direction == 0) {
+      along = max(along,
+                  segments(net[k], net[4 + k], net[8 + k], net[12 + k]));
+      across = max(across, polyline_length(net[k * 4], net[k * 4 + 1],
+                                           net[k * 4 + 2], net[k * 4 + 3]));
+    } else {
+      along = max(along, segments(net[k * 4], net[k * 4 + 1],
+                                  net[k * 4 + 2], net[k * 4 + 3]));
+      across = max(across, polyline_length(net[k], net[4 + k], net[8 + k],
+                                           net[12 + k]));
+    }
+  }
+
+  // the evaluation shader spreads lines over both patch edges, so at least
+  // two are needed
+  float lines = clamp(ceil(across / min_line_spacing) + 1.0, 2.0,
+                      float(max(u_sub, 2u)));
+  float levels = min(along, max_level);
+  gl_TessLevelOuter[0] = lines;
+  gl_TessLevelOuter[1] = levels;
+  gl_TessLevelOuter[2] = lines;
+  gl_TessLevelOuter[3] = levels;
+}
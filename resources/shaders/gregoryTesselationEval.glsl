@@ -2,9 +2,11 @@
 
 layout(isolines, equal_spacing, ccw) in;
 
-uniform mat4 view;
-uniform mat4 projection;
-uniform uint direction;
+layout(std140, binding = 0) uniform Camera {
+  mat4 view;
+  mat4 projection;
+};
+patch in uint direction;
 
 out vec2 trim_coord;
 
@@ -1,9 +1,11 @@
-#version 330
+#version 430
 
 out vec3 worldPos;
 
-uniform mat4 view;
-uniform mat4 projection;
+layout(std140, binding = 0) uniform Camera {
+  mat4 view;
+  mat4 projection;
+};
 uniform vec3 cameraWorldPos;
 uniform float gridSize = 100.0f;
 
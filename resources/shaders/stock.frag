@@ -0,0 +1,15 @@
+#version 430 core
+
+in vec3 worldPos;
+in vec3 normal;
+
+uniform vec4 color;
+
+out vec4 FragColor;
+
+const vec3 lightDirection = normalize(vec3(0.4, 1.0, 0.3));
+
+void main() {
+  float diffuse = max(dot(normalize(normal), lightDirection), 0.0);
+  FragColor = vec4(color.rgb * (0.25 + 0.75 * diffuse), color.a);
+}
@@ -0,0 +1,36 @@
+#version 430 core
+
+layout(std140, binding = 0) uniform Camera {
+  mat4 view;
+  mat4 projection;
+};
+uniform sampler2D heights;
+uniform vec2 blockSize;
+uniform float heightOffset;
+
+out vec3 worldPos;
+out vec3 normal;
+
+float heightAt(ivec2 texel, ivec2 size) {
+  return texelFetch(heights, clamp(texel, ivec2(0), size - 1), 0).r;
+}
+
+void main() {
+  ivec2 size = textureSize(heights, 0);
+  /// one instance per strip between rows, vertices alternate between them
+  ivec2 texel = ivec2(gl_VertexID / 2, gl_InstanceID + (gl_VertexID & 1));
+  vec2 texelSize = blockSize / vec2(size);
+
+  float h = heightAt(texel, size);
+  float dx = heightAt(texel + ivec2(1, 0), size) -
+             heightAt(texel - ivec2(1, 0), size);
+  float dz = heightAt(texel + ivec2(0, 1), size) -
+             heightAt(texel - ivec2(0, 1), size);
+
+  worldPos = vec3(-0.5 * blockSize.x + texelSize.x * texel.x, h + heightOffset,
+                  -0.5 * blockSize.y + texelSize.y * texel.y);
+  normal = normalize(
+      vec3(-dx / (2.0 * texelSize.x), 1.0, -dz / (2.0 * texelSize.y)));
+
+  gl_Position = projection * view * vec4(worldPos, 1.0);
+}
@@ -2,18 +2,112 @@
 
 layout(vertices = 16) out;
 
+layout(std140, binding = 0) uniform Camera {
+  mat4 view;
+  mat4 projection;
+};
 uniform uint u_subdivisions;
 uniform uint v_subdivisions;
-uniform uint direction;
+in uint vs_instance[];
+patch out uint direction;
+// viewport size in pixels
+uniform vec2 viewport;
+// largest distance in pixels between a segment and the curve it replaces
+uniform float pixel_error;
+
+const float max_level = 64.0;
+// isolines closer than this many pixels are merged
+const float min_line_spacing = 4.0;
+
+vec4 clip_position(uint up, uint vp) {
+  return projection * view * gl_in[up * 4 + vp].gl_Position;
+}
+
+// the patch lies in the convex hull of its control points
+bool outside_frustum(vec4 c[16]) {
+  for (int axis = 0; axis < 3; ++axis) {
+    bool below = true;
+    bool above = true;
+    for (int i = 0; i < 16; ++i) {
+      below = below && c[i][axis] < -c[i].w;
+      above = above && c[i][axis] > c[i].w;
+    }
+    if (below || above) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// segments keeping a cubic within pixel_error of its polyline, bounded by
+// its second differences
+float segments(vec2 b0, vec2 b1, vec2 b2, vec2 b3) {
+  float second = max(length(b0 - 2.0 * b1 + b2), length(b1 - 2.0 * b2 + b3));
+  return ceil(sqrt(0.75 * second / pixel_error));
+}
+
+float polyline_length(vec2 b0, vec2 b1, vec2 b2, vec2 b3) {
+  return length(b1 - b0) + length(b2 - b1) + length(b3 - b2);
+}
 
 void main() {
   gl_out[gl_InvocationID].gl_Position = gl_in[gl_InvocationID].gl_Position;
+  if (gl_InvocationID != 0) {
+    return;
+  }
+  direction = vs_instance[0];
 
-  if (direction == 0) {
-    gl_TessLevelOuter[0] = u_subdivisions + 1;
-    gl_TessLevelOuter[1] = v_subdivisions;
-  } else {
-    gl_TessLevelOuter[0] = v_subdivisions + 1;
-    gl_TessLevelOuter[1] = u_subdivisions;
+  vec4 c[16];
+  bool behind = false;
+  for (uint up = 0; up < 4; ++up) {
+    for (uint vp = 0; vp < 4; ++vp) {
+      c[up * 4 + vp] = clip_position(up, vp);
+      behind = behind || c[up * 4 + vp].w <= 0.0;
+    }
   }
+
+  if (outside_frustum(c)) {
+    gl_TessLevelOuter[0] = 0.0;
+    gl_TessLevelOuter[1] = 0.0;
+    return;
+  }
+
+  uint lines = direction == 0 ? u_subdivisions + 1 : v_subdivisions + 1;
+  uint user_segments = direction == 0 ? v_subdivisions : u_subdivisions;
+
+  // screen positions are meaningless across the eye plane, keep the user set
+  // density there
+  if (behind) {
+    gl_TessLevelOuter[0] = lines;
+    gl_TessLevelOuter[1] = max(user_segments, 1u);
+    return;
+  }
+
+  vec2 s[16];
+  for (int i = 0; i < 16; ++i) {
+    s[i] = 0.5 * c[i].xy / c[i].w * viewport;
+  }
+
+  // direction 0 draws lines along the first control point index
+  float along = 1.0;
+  float across = 0.0;
+  for (int k = 0; k < 4; ++k) {
+    if (direction == 0) {
+      along = max(along, segments(s[k], s[4 + k], s[8 + k], s[12 + k]));
+      across = max(across,
+                   polyline_length(s[k * 4], s[k * 4 + 1], s[k * 4 + 2],
+                                   s[k * 4 + 3]));
+    } else {
+      along = max(along, segments(s[k * 4], s[k * 4 + 1], s[k * 4 + 2],
+                                  s[k * 4 + 3]));
+      across = max(across,
+                   polyline_length(s[k], s[4 + k], s[8 + k], s[12 + k]));
+    }
+  }
+
+  // the evaluation shader spreads lines over both patch edges, so at least
+  // two are needed
+  float visible_lines = ceil(across / min_line_spacing) + 1.0;
+  gl_TessLevelOuter[0] = clamp(visible_lines, 2.0, float(max(lines, 2u)));
+  gl_TessLevelOuter[1] = min(along, max_level);
 }
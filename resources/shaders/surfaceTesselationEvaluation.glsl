@@ -3,8 +3,10 @@
 layout(quads, equal_spacing, ccw) in;
 
 // uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+layout(std140, binding = 0) uniform Camera {
+  mat4 view;
+  mat4 projection;
+};
 uniform uint v_patches;
 uniform uint u_patches;
 
@@ -4,8 +4,10 @@ layout(location = 1) in vec2 aTexCoord;
 
 out vec2 TexCoord;
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+layout(std140, binding = 0) uniform Camera {
+  mat4 view;
+  mat4 projection;
+};
 
 void main() {
   gl_Position = projection * view * model * vec4(position, 1.0f);
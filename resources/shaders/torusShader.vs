@@ -2,8 +2,10 @@
 layout(location = 0) in vec3 position;
 layout(location = 1) in vec2 uv;
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+layout(std140, binding = 0) uniform Camera {
+  mat4 view;
+  mat4 projection;
+};
 out vec2 trim_coord;
 const float pi2 = 2.0 * 3.14159265359;
 
@@ -2,7 +2,9 @@
 
 layout(location = 0) in vec3 position;
 
-uniform mat4 view;
-uniform mat4 projection;
+layout(std140, binding = 0) uniform Camera {
+  mat4 view;
+  mat4 projection;
+};
 
 void main() { gl_Position = projection * view * vec4(position, 1.0); }
@@ -1,5 +1,10 @@
 #version 430
 
 layout(location = 0) in vec3 position;
+// isoline direction, both are drawn as two instances of one draw
+out uint vs_instance;
 
-void main() { gl_Position = vec4(position, 1.0f); }
\ No newline at end of file
+void main() {
+  gl_Position = vec4(position, 1.0f);
+  vs_instance = uint(gl_InstanceID);
+}
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include "app.hpp"
 #include "appConfig.hpp"
 #include "imgui.h"
+#include "profiler.hpp"
+#include "renderStats.hpp"
 
 #include "sceneRenderer.hpp"
 #include <cstdlib>
@@ -67,6 +69,7 @@ void App::initImgui() {
 }
 
 void App::mainLoop() {
+  Profiler::instance().setThreadName("main");
   while (!glfwWindowShouldClose(window_)) {
     glfwPollEvents();
 
@@ -74,6 +77,9 @@ void App::mainLoop() {
       ImGui_ImplGlfw_Sleep(10);
       continue;
     }
+    PROFILE_SCOPE("frame");
+    RenderStats::instance().beginFrame();
+    gui_->processCompletedTasks();
 
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplGlfw_NewFrame();
@@ -97,7 +103,8 @@ void App::mainLoop() {
       sceneRenderer_->renderCenterPoint(*gui_->getCenterPoint().value());
     }
 
-    if (gui_->getMouse().leftButtonDown() && !scene_->getPickables().empty()) {
+    if (gui_->gpuPicking() && gui_->getMouse().leftButtonDown() &&
+        !scene_->getPickables().empty()) {
       sceneRenderer_->renderPicking(scene_->getPickables());
     }
 
@@ -105,6 +112,7 @@ void App::mainLoop() {
     sceneRenderer_->renderCursor(gui_->getCursor());
     sceneRenderer_->renderVirtualPoints(gui_->getVirtualPoints());
     sceneRenderer_->renderMillingPaths(gui_->selectedMillingPaths());
+    sceneRenderer_->renderStock(gui_->stockSimulation());
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
     glfwSwapBuffers(window_);
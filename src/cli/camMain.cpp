@@ -0,0 +1,141 @@
+#include "bezierSurface.hpp"
+#include "binaryScene.hpp"
+#include "jsonSerializer.hpp"
+#include "jsonDeserializer.hpp"
+#include "pathsGenerator.hpp"
+#include "scene.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <print>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// Batch CAM: loads a scene, generates height map, roughing and flat paths
+/// for all its Bezier surfaces and writes the G-code files. Built with
+/// ARMCADILLO_HEADLESS, no window or GL context is ever created.
+///
+/// Detailed paths are left to the app, they need intersection textures
+/// trimmed by hand.
+///
+/// With --convert the scene is only written to the given path, in the binary
+/// format when it has the binary scene extension and as JSON otherwise.
+
+namespace {
+
+struct Options {
+  std::filesystem::path scene_;
+  std::filesystem::path output_ = ".";
+  std::filesystem::path convert_;
+  bool arcs_ = false;
+};
+
+constexpr std::string_view kUsage =
+    "usage: armCADillo-cam <scene> [--output <dir>] [--arcs] "
+    "[--convert <scene>]";
+
+Options parseOptions(int argc, char **argv) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view argument = argv[i];
+    if (argument == "--arcs") {
+      options.arcs_ = true;
+    } else if (argument == "--output" && i + 1 < argc) {
+      options.output_ = argv[++i];
+    } else if (argument == "--convert" && i + 1 < argc) {
+      options.convert_ = argv[++i];
+    } else if (!argument.starts_with("--") && options.scene_.empty()) {
+      options.scene_ = argument;
+    } else {
+      throw std::runtime_error(std::string(kUsage));
+    }
+  }
+
+  if (options.scene_.empty()) {
+    throw std::runtime_error(std::string(kUsage));
+  }
+  return options;
+}
+
+std::vector<BezierSurface *> modelSurfaces(const Scene &scene) {
+  std::vector<BezierSurface *> surfaces;
+  for (auto *entity : scene.getEntites()) {
+    if (auto *surface = dynamic_cast<BezierSurface *>(entity)) {
+      surfaces.push_back(surface);
+    }
+  }
+  return surfaces;
+}
+
+void loadScene(const std::string &path, Scene &scene) {
+  if (BinaryScene::matches(path)) {
+    BinaryScene(path).load(scene);
+  } else {
+    const JsonDeserializer deserializer;
+    deserializer.loadScence(path, scene);
+  }
+}
+
+void saveScene(const Scene &scene, const std::filesystem::path &path) {
+  if (path.extension() == BinaryScene::kExtension) {
+    BinaryScene::save(scene, path.string());
+  } else {
+    JsonSerializer serializer;
+    serializer.getSavePath() = path.string();
+    serializer.serializeScene(scene);
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  try {
+    const auto options = parseOptions(argc, argv);
+    if (!std::filesystem::exists(options.scene_)) {
+      throw std::runtime_error("Scene not found: " + options.scene_.string());
+    }
+
+    Scene scene(nullptr);
+    loadScene(options.scene_.string(), scene);
+
+    if (!options.convert_.empty()) {
+      saveScene(scene, options.convert_);
+      std::println("converted {} to {}", options.scene_.string(),
+                   options.convert_.string());
+      return EXIT_SUCCESS;
+    }
+
+    const auto surfaces = modelSurfaces(scene);
+    if (surfaces.empty()) {
+      throw std::runtime_error("No Bezier surfaces in " +
+                               options.scene_.string());
+    }
+
+    /// G-code files land in the working directory
+    std::filesystem::create_directories(options.output_);
+    std::filesystem::current_path(options.output_);
+
+    PathsGenerator generator;
+    generator.setScene(&scene);
+    generator.dialect().arcs_ = options.arcs_;
+    generator.setModel(surfaces);
+
+    const auto start = std::chrono::steady_clock::now();
+    generator.run();
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    std::println("total: {:.1f} ms, {} surfaces, written to {}",
+                 elapsed.count(), surfaces.size(),
+                 std::filesystem::current_path().string());
+  } catch (const std::exception &e) {
+    std::println(stderr, "{}", e.what());
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
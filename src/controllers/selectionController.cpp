@@ -4,11 +4,22 @@
 #include "imgui.h"
 #include "mouse.hpp"
 #include <algorithm>
-#include <print>
-#include <unordered_set>
+#include <cstdint>
+#include <span>
 #include <vector>
 
 std::optional<IEntity *> SelectionController::getEntity(float x, float y) {
+  if (!_gpuPicking) {
+    updatePointIndex();
+    const auto ndc_min = toNdc({x - kClickRadius, y + kClickRadius});
+    const auto ndc_max = toNdc({x + kClickRadius, y - kClickRadius});
+    if (auto *entity =
+            _pointIndex.pickNearest(viewProjection(), ndc_min, ndc_max)) {
+      return entity;
+    }
+    return std::nullopt;
+  }
+
   PickingTexture::PixelInfo pixel =
       _pickingTexture.ReadPixel(x, GLFWHelper::getHeight(_window) - y - 1);
   if (pixel.ObjectId == 0) {
@@ -16,14 +27,19 @@ std::optional<IEntity *> SelectionController::getEntity(float x, float y) {
   }
   auto clickedObjectId = pixel.ObjectId - 1;
 
-  auto sceneEntities = _scene->getPoints();
-  if (clickedObjectId > sceneEntities.size()) {
+  /// picking ids index the pickables the picking pass rendered
+  const auto &sceneEntities = _scene->getPickables();
+  if (clickedObjectId >= sceneEntities.size()) {
     return std::nullopt;
   }
   return sceneEntities[clickedObjectId];
 }
 
 void SelectionController::process(const Mouse &mouse) {
+  if (_pickingTexture.regionReady()) {
+    applyBoxSelection(collectBoxSelection(), _appendBoxSelection);
+  }
+
   if (ImGui::IsAnyItemActive()) {
     return; // This maybe unnecessary
   }
@@ -61,60 +77,101 @@ void SelectionController::process(const Mouse &mouse) {
   else if (ImGui::IsMouseReleased(ImGuiMouseButton_Left) &&
            mouse._isSelectionBoxActive) {
     mouse._isSelectionBoxActive = false;
-    const auto &entities = getEntities(mouse.getLastClickedPosition(),
-                                       mouse.getCurrentPosition(), 4);
-    if (!ImGui::GetIO().KeyCtrl) {
-      if (_selectedEntities.empty()) {
-        _selectedEntities = entities;
-      }
+    if (_gpuPicking) {
+      requestBoxSelection(mouse.getLastClickedPosition(),
+                          mouse.getCurrentPosition());
+      _appendBoxSelection = ImGui::GetIO().KeyCtrl;
     } else {
-      for (const auto &entity : entities) {
-        if (std::ranges::find(_selectedEntities, entity) ==
-            _selectedEntities.end()) {
-          _selectedEntities.emplace_back(entity);
-        }
-      }
+      applyBoxSelection(queryBox(mouse.getLastClickedPosition(),
+                                 mouse.getCurrentPosition()),
+                        ImGui::GetIO().KeyCtrl);
     }
   }
 }
 
-std::vector<IEntity *>
-SelectionController::getEntities(const algebra::Vec2f &startPos,
-                                 const algebra::Vec2f &endPos,
-                                 int stride /* = 1 */) {
-  std::vector<IEntity *> selectedEntities;
-
-  int minX =
-      std::min(static_cast<int>(startPos[0]), static_cast<int>(endPos[0]));
-  int maxX =
-      std::max(static_cast<int>(startPos[0]), static_cast<int>(endPos[0]));
-  int minY =
-      std::min(static_cast<int>(startPos[1]), static_cast<int>(endPos[1]));
-  int maxY =
-      std::max(static_cast<int>(startPos[1]), static_cast<int>(endPos[1]));
-
-  auto sceneEntities = _scene->getPoints();
-  std::unordered_set<int> uniqueIds;
-
-  for (int y = minY; y <= maxY; y += stride) {
-    for (int x = minX; x <= maxX; x += stride) {
-      auto pixel =
-          _pickingTexture.ReadPixel(x, GLFWHelper::getHeight(_window) - y - 1);
-
-      if (pixel.ObjectId == 0) {
-        continue;
+void SelectionController::applyBoxSelection(
+    const std::vector<IEntity *> &entities, bool append) {
+  if (!append) {
+    if (_selectedEntities.empty()) {
+      _selectedEntities = entities;
+    }
+  } else {
+    for (const auto &entity : entities) {
+      if (std::ranges::find(_selectedEntities, entity) ==
+          _selectedEntities.end()) {
+        _selectedEntities.emplace_back(entity);
       }
+    }
+  }
+}
 
-      int objId = static_cast<int>(pixel.ObjectId) - 1;
-      if (objId < 0 || objId >= static_cast<int>(sceneEntities.size())) {
-        continue;
-      }
+void SelectionController::updatePointIndex() {
+  _pointIndex.update(_scene->getPickables());
+}
+
+algebra::Mat4f SelectionController::viewProjection() const {
+  return _camera.projectionMatrix() * _camera.viewMatrix();
+}
+
+algebra::Vec2f
+SelectionController::toNdc(const algebra::Vec2f &windowPos) const {
+  const auto width = static_cast<float>(GLFWHelper::getWidth(_window));
+  const auto height = static_cast<float>(GLFWHelper::getHeight(_window));
+  return {(2.f * windowPos[0]) / width - 1.f,
+          1.f - (2.f * windowPos[1]) / height};
+}
+
+const std::vector<IEntity *> &
+SelectionController::queryBox(const algebra::Vec2f &startPos,
+                              const algebra::Vec2f &endPos) {
+  updatePointIndex();
+  const auto start = toNdc(startPos);
+  const auto end = toNdc(endPos);
+  const algebra::Vec2f ndc_min(std::min(start[0], end[0]),
+                               std::min(start[1], end[1]));
+  const algebra::Vec2f ndc_max(std::max(start[0], end[0]),
+                               std::max(start[1], end[1]));
+
+  _boxSelection.clear();
+  _pointIndex.queryRect(viewProjection(), ndc_min, ndc_max, _boxSelection);
+  return _boxSelection;
+}
 
-      if (uniqueIds.insert(objId).second) {
-        selectedEntities.push_back(sceneEntities[objId]);
+void SelectionController::requestBoxSelection(const algebra::Vec2f &startPos,
+                                              const algebra::Vec2f &endPos) {
+  const int width = GLFWHelper::getWidth(_window);
+  const int height = GLFWHelper::getHeight(_window);
+  if (width <= 0 || height <= 0) {
+    return;
+  }
+
+  const auto to_pixel = [](float value, int size) {
+    return std::clamp(static_cast<int>(value), 0, size - 1);
+  };
+  const int min_x = to_pixel(std::min(startPos[0], endPos[0]), width);
+  const int max_x = to_pixel(std::max(startPos[0], endPos[0]), width);
+  const int min_y = to_pixel(std::min(startPos[1], endPos[1]), height);
+  const int max_y = to_pixel(std::max(startPos[1], endPos[1]), height);
+
+  /// window rows grow downwards, texture rows upwards
+  _pickingTexture.requestRegion(min_x, height - max_y - 1, max_x - min_x + 1,
+                                max_y - min_y + 1);
+}
+
+const std::vector<IEntity *> &SelectionController::collectBoxSelection() {
+  const auto &pickables = _scene->getPickables();
+  _boxSelection.clear();
+  _seenIds.assign(pickables.size(), false);
+
+  _pickingTexture.consumeRegion([&](std::span<const uint32_t> ids) {
+    for (const uint32_t id : ids) {
+      if (id == 0 || id > pickables.size() || _seenIds[id - 1]) {
+        continue;
       }
+      _seenIds[id - 1] = true;
+      _boxSelection.push_back(pickables[id - 1]);
     }
-  }
+  });
 
-  return selectedEntities;
+  return _boxSelection;
 }
@@ -1,8 +1,10 @@
 #pragma once
 #include "IController.hpp"
 #include "IEntity.hpp"
+#include "camera.hpp"
 #include "imgui.h"
 #include "pickingTexture.hpp"
+#include "pointIndex.hpp"
 #include "scene.hpp"
 #include <algorithm>
 #include <memory>
@@ -15,8 +17,10 @@
 class SelectionController : public IController {
 public:
   SelectionController(GLFWwindow *window, const Scene *scene,
+                      const Camera &camera,
                       std::vector<IEntity *> &selectedEntities)
-      : _window(window), _scene(scene), _selectedEntities(selectedEntities) {
+      : _window(window), _scene(scene), _camera(camera),
+        _selectedEntities(selectedEntities) {
 
     _pickingTexture.init(GLFWHelper::getWidth(_window),
                          GLFWHelper::getHeight(_window));
@@ -28,16 +32,35 @@ public:
   void process(const Mouse & /*mouse*/) override;
 
   PickingTexture &getPickingTexture() { return _pickingTexture; }
+  /// select through the picking pass instead of the CPU point index
+  bool &gpuPicking() { return _gpuPicking; }
 
 private:
+  /// half size in pixels of the area a click selects from
+  static constexpr float kClickRadius = 6.f;
+
   GLFWwindow *_window = nullptr;
   const Scene *_scene = nullptr;
+  const Camera &_camera;
   std::vector<IEntity *> &_selectedEntities;
   PickingTexture _pickingTexture;
+  PointIndex _pointIndex;
+  bool _gpuPicking = false;
   bool _selectionBoxActive = false;
 
+  /// box selections are read back a frame later, these carry them over
+  bool _appendBoxSelection = false;
+  std::vector<IEntity *> _boxSelection;
+  std::vector<bool> _seenIds;
+
   std::optional<IEntity *> getEntity(float x, float y);
-  std::vector<IEntity *> getEntities(const algebra::Vec2f &startPos,
-                                     const algebra::Vec2f &endPos,
-                                     int stride = 1);
+  void updatePointIndex();
+  algebra::Mat4f viewProjection() const;
+  algebra::Vec2f toNdc(const algebra::Vec2f &windowPos) const;
+  const std::vector<IEntity *> &queryBox(const algebra::Vec2f &startPos,
+                                         const algebra::Vec2f &endPos);
+  void requestBoxSelection(const algebra::Vec2f &startPos,
+                           const algebra::Vec2f &endPos);
+  const std::vector<IEntity *> &collectBoxSelection();
+  void applyBoxSelection(const std::vector<IEntity *> &entities, bool append);
 };
\ No newline at end of file
@@ -1,11 +1,16 @@
 #include "IEntity.hpp"
+#include "transformations.hpp"
+#ifndef ARMCADILLO_HEADLESS
 #include "imgui.h"
 #include "imgui_stdlib.h"
-#include "transformations.hpp"
+#endif
 
 bool IEntity::acceptVisitor(IVisitor &visitor) { return false; };
 
 bool IEntity::renderSettings(const GUI &gui) {
+#ifdef ARMCADILLO_HEADLESS
+  return false;
+#else
   ImGui::InputText("Name", &getName());
   float position[3] = {_position[0], _position[1], _position[2]};
 
@@ -15,13 +20,20 @@ bool IEntity::renderSettings(const GUI &gui) {
   }
 
   return false;
+#endif
 }
 
 algebra::Vec3f &IEntity::getScale() { return _scale; }
 const algebra::Vec3f &IEntity::getScale() const { return _scale; }
 
 void IEntity::updatePosition(const algebra::Vec3f &position) {
+  /// some callers set the same position every frame, that is no change
+  if (position[0] == _position[0] && position[1] == _position[1] &&
+      position[2] == _position[2]) {
+    return;
+  }
   _position = position;
+  positionsChanged();
 }
 const algebra::Vec3f &IEntity::getPosition() const { return _position; }
 
@@ -48,6 +60,7 @@ void IEntity::rotateAroundPoint(const algebra::Quaternion<float> &rotation,
   auto rotatedAtOrigin = rotation * (_position - point);
   _position = rotatedAtOrigin.toVector() + point;
   _rotation = rotation * _rotation;
+  positionsChanged();
 }
 
 void IEntity::scaleAroundPoint(float scaleFactor,
@@ -57,6 +70,7 @@ void IEntity::scaleAroundPoint(float scaleFactor,
 
   //_scale = _scale * scaleFactor;
   _position = translatedPosition + centerPoint;
+  positionsChanged();
 }
 
 const uint32_t &IEntity::getId() const { return _id; }
@@ -5,6 +5,7 @@
 #include "matrix.hpp"
 #include "quaternion.hpp"
 #include "vec.hpp"
+#include <cstdint>
 
 class GUI;
 
@@ -38,6 +39,10 @@ public:
   const bool &dirty() const;
   bool &dirty();
 
+  /// bumped whenever any entity moves, lets caches over positions tell they
+  /// went stale without subscribing to every entity
+  static uint64_t positionsVersion() { return kPositionsVersion; }
+
 protected:
   algebra::Vec3f _position;
   algebra::Quaternion<float> _rotation;
@@ -45,4 +50,9 @@ protected:
   std::string _name;
   bool _dirty = false;
   uint32_t _id;
+
+  static void positionsChanged() { ++kPositionsVersion; }
+
+private:
+  inline static uint64_t kPositionsVersion = 0;
 };
\ No newline at end of file
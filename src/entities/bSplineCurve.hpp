@@ -20,6 +20,9 @@ public:
 
   void addPoint(PointEntity &point) override;
   std::vector<VirtualPoint *> getVirtualPoints() const;
+  const std::vector<std::unique_ptr<VirtualPoint>> &bezierPoints() const {
+    return _bezierPoints;
+  }
   bool &showBezierPoints();
 
 private:
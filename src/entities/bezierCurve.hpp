@@ -21,7 +21,6 @@ public:
     return _points;
   }
   void updateMesh() override { _mesh = generateMesh(); };
-  void markToUpdate() override { _dirty = true; }
   void update() override { updateMesh(); }
   void onSubscribableDestroyed(ISubscribable &publisher) override {
 
@@ -1,9 +1,46 @@
 #include "bezierSurface.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 void BezierSurface::update() {
-  _polyMesh = createPolyMesh();
+  const auto moved = takeMovedPoints();
+  if (_mesh && moved.empty()) {
+    return;
+  }
+
+  if (!_mesh || moved.size() * kPartialUpdateDivisor > _points.size()) {
+    _polyMesh = createPolyMesh();
+    updateAlgebraicSurfaceC0();
+    updateMesh();
+    return;
+  }
+
+  for (const auto index : moved) {
+    const auto &position = _builtPositions[index];
+    const std::array<float, 3> vertex{position[0], position[1], position[2]};
+    _polyMesh->updateVertices(3 * static_cast<size_t>(index), vertex);
+  }
+  updatePatches(moved);
   updateAlgebraicSurfaceC0();
-  updateMesh();
+}
+
+std::vector<uint32_t> BezierSurface::takeMovedPoints() {
+  const bool resized = _builtPositions.size() != _points.size();
+  _builtPositions.resize(_points.size());
+
+  std::vector<uint32_t> moved;
+  for (uint32_t i = 0; i < _points.size(); ++i) {
+    const auto &position = _points[i].get().getPosition();
+    auto &built = _builtPositions[i];
+    if (resized || position[0] != built[0] || position[1] != built[1] ||
+        position[2] != built[2]) {
+      built = position;
+      moved.push_back(i);
+    }
+  }
+  return moved;
 }
 
 std::vector<std::reference_wrapper<const PointEntity>>
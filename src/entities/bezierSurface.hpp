@@ -9,6 +9,7 @@
 #include "pointEntity.hpp"
 #include "surface.hpp"
 #include "vec.hpp"
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -51,7 +52,6 @@ public:
     return visitor.visitBezierSurface(*this);
   };
 
-  void markToUpdate() override { _dirty = true; }
   void update() override;
   void onSubscribableDestroyed(ISubscribable &publisher) override {}
 
@@ -102,8 +102,20 @@ protected:
   bool _wireframe = false;
   algebra::ConnectionType _connectionType;
   std::unique_ptr<algebra::BezierSurfaceC0> _algebraSurfaceC0;
+  /// control point positions the meshes were last built from
+  std::vector<algebra::Vec3f> _builtPositions;
 
   virtual void updateAlgebraicSurfaceC0() = 0;
+  /// rewrites the patches the given control points contribute to
+  virtual void updatePatches(const std::vector<uint32_t> &movedPoints) = 0;
 
   std::unique_ptr<Mesh> createPolyMesh();
+
+private:
+  /// when at most this share of the control points moved, only their
+  /// patches are uploaded again
+  static constexpr size_t kPartialUpdateDivisor = 2;
+
+  /// indices of control points that moved since the last update
+  std::vector<uint32_t> takeMovedPoints();
 };
\ No newline at end of file
@@ -2,6 +2,8 @@
 #include "bezierSurface.hpp"
 #include "surface.hpp"
 #include "vec.hpp"
+#include <algorithm>
+#include <array>
 #include <memory>
 #include <ranges>
 
@@ -64,7 +66,6 @@ BezierSurfaceC0::BezierSurfaceC0(
   }
 
   _connectionType = connectionType;
-  _polyMesh = createPolyMesh();
   _patches = {.colCount = uCount, .rowCount = vCount};
   update();
 }
@@ -81,6 +82,50 @@ std::unique_ptr<BezierSurfaceMesh> BezierSurfaceC0::generateMesh() {
                                    _patches.rowCount);
 }
 
+void BezierSurfaceC0::updatePatches(const std::vector<uint32_t> &movedPoints) {
+  const uint32_t u_patches = _patches.colCount;
+  const uint32_t v_patches = _patches.rowCount;
+  const uint32_t u_points = 3 * u_patches + 1;
+
+  /// a point on a patch border belongs to the patches on both sides
+  const auto patch_range = [](uint32_t point, uint32_t patches) {
+    return std::array<uint32_t, 2>{point < 3 ? 0 : (point - 1) / 3,
+                                   std::min(point / 3, patches - 1)};
+  };
+
+  std::vector<bool> dirty(u_patches * v_patches, false);
+  for (const auto index : movedPoints) {
+    const auto [u_first, u_last] = patch_range(index % u_points, u_patches);
+    const auto [v_first, v_last] = patch_range(index / u_points, v_patches);
+    for (uint32_t v_idx = v_first; v_idx <= v_last; ++v_idx) {
+      for (uint32_t u_idx = u_first; u_idx <= u_last; ++u_idx) {
+        dirty[v_idx * u_patches + u_idx] = true;
+      }
+    }
+  }
+
+  /// same layout as BezierSurfaceMesh::createC0MeshData
+  std::array<float, BezierSurfaceMesh::kPatchFloats> patch_data{};
+  for (uint32_t v_idx = 0; v_idx < v_patches; ++v_idx) {
+    for (uint32_t u_idx = 0; u_idx < u_patches; ++u_idx) {
+      if (!dirty[v_idx * u_patches + u_idx]) {
+        continue;
+      }
+      for (uint32_t i = 0; i < 4; ++i) {
+        for (uint32_t j = 0; j < 4; ++j) {
+          const auto &position =
+              _builtPositions[(v_idx * 3 + j) * u_points + u_idx * 3 + i];
+          const uint32_t offset = 3 * (4 * i + j);
+          patch_data[offset] = position[0];
+          patch_data[offset + 1] = position[1];
+          patch_data[offset + 2] = position[2];
+        }
+      }
+      _mesh->updatePatch(v_idx * u_patches + u_idx, patch_data);
+    }
+  }
+}
+
 void BezierSurfaceC0::updateAlgebraicSurfaceC0() {
   std::vector<algebra::Vec3f> points(_points.size());
   for (const auto &[i, p] : _points | std::views::enumerate) {
@@ -32,4 +32,5 @@ private:
   inline static int kClassId = 0;
   std::unique_ptr<BezierSurfaceMesh> generateMesh();
   void updateAlgebraicSurfaceC0() override;
+  void updatePatches(const std::vector<uint32_t> &movedPoints) override;
 };
@@ -2,6 +2,7 @@
 #include "bezierSurface.hpp"
 #include "surface.hpp"
 #include "vec.hpp"
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <memory>
@@ -10,44 +11,94 @@
 #include <ranges>
 
 void BezierSurfaceC2::updateBezierSurface() {
-  _bezierControlPoints.clear();
-  _rowOrderBezierControlPoints.clear();
-
   const uint32_t col_patches = _patches.colCount;
   const uint32_t row_patches = _patches.rowCount;
-  const uint32_t bezier_cols = 3 * col_patches + 1;
-  _rowOrderBezierControlPoints.resize((3 * row_patches + 1) * bezier_cols);
-  const uint32_t col_deboor_points = 3 + col_patches;
+  _bezierControlPoints.resize(16 * row_patches * col_patches);
+  _rowOrderBezierControlPoints.resize((3 * row_patches + 1) *
+                                      (3 * col_patches + 1));
 
   for (uint32_t row_patch = 0; row_patch < row_patches; ++row_patch) {
     for (uint32_t col_patch = 0; col_patch < col_patches; ++col_patch) {
+      updateBezierPatch(row_patch, col_patch);
+    }
+  }
+  updateAlgebraicSurfaceC0();
+}
 
-      std::array<std::array<algebra::Vec3f, 4>, 4> patch;
-      for (int j = 0; j < 4; ++j) {
-        for (int i = 0; i < 4; ++i) {
-          patch[i][j] =
-              _points[(row_patch + i) * col_deboor_points + col_patch + j]
-                  .get()
-                  .getPosition();
-        }
+std::array<std::array<algebra::Vec3f, 4>, 4>
+BezierSurfaceC2::updateBezierPatch(uint32_t rowPatch, uint32_t colPatch) {
+  const uint32_t col_patches = _patches.colCount;
+  const uint32_t col_deboor_points = 3 + col_patches;
+
+  std::array<std::array<algebra::Vec3f, 4>, 4> patch;
+  for (int j = 0; j < 4; ++j) {
+    for (int i = 0; i < 4; ++i) {
+      patch[i][j] = _points[(rowPatch + i) * col_deboor_points + colPatch + j]
+                        .get()
+                        .getPosition();
+    }
+  }
+
+  auto final_patch = processPatch(patch);
+
+  const uint32_t first = 16 * (rowPatch * col_patches + colPatch);
+  for (const auto &[rowCount, row] : final_patch | std::views::enumerate) {
+    for (const auto &[colCount, col] : row | std::views::enumerate) {
+      const uint32_t global_row = rowPatch * 3 + rowCount;
+      const uint32_t global_col = colPatch * 3 + colCount;
+      const uint32_t global_index =
+          global_row * (3 * col_patches + 1) + global_col;
+      _rowOrderBezierControlPoints[global_index] = col;
+      _bezierControlPoints[first + 4 * rowCount + colCount] = col;
+    }
+  }
+  return final_patch;
+}
+
+void BezierSurfaceC2::updatePatches(const std::vector<uint32_t> &movedPoints) {
+  const uint32_t col_patches = _patches.colCount;
+  const uint32_t row_patches = _patches.rowCount;
+  const uint32_t col_deboor_points = 3 + col_patches;
+
+  /// a de Boor point shapes up to four patches in each direction
+  const auto patch_range = [](uint32_t point, uint32_t patches) {
+    return std::array<uint32_t, 2>{point < 3 ? 0 : point - 3,
+                                   std::min(point, patches - 1)};
+  };
+
+  std::vector<bool> dirty(row_patches * col_patches, false);
+  for (const auto index : movedPoints) {
+    const auto [row_first, row_last] =
+        patch_range(index / col_deboor_points, row_patches);
+    const auto [col_first, col_last] =
+        patch_range(index % col_deboor_points, col_patches);
+    for (uint32_t row_patch = row_first; row_patch <= row_last; ++row_patch) {
+      for (uint32_t col_patch = col_first; col_patch <= col_last;
+           ++col_patch) {
+        dirty[row_patch * col_patches + col_patch] = true;
       }
+    }
+  }
 
-      auto final_patch = processPatch(patch);
-
-      for (const auto &[rowCount, row] : final_patch | std::views::enumerate) {
-        for (const auto &[colCount, col] : row | std::views::enumerate) {
-          const uint32_t global_row = row_patch * 3 + rowCount;
-          const uint32_t global_col = col_patch * 3 + colCount;
-          const uint32_t global_index =
-              global_row * (3 * col_patches + 1) + global_col;
-          _rowOrderBezierControlPoints[global_index] =
-              final_patch[rowCount][colCount];
-          _bezierControlPoints.emplace_back(col);
+  std::array<float, BezierSurfaceMesh::kPatchFloats> patch_data{};
+  for (uint32_t row_patch = 0; row_patch < row_patches; ++row_patch) {
+    for (uint32_t col_patch = 0; col_patch < col_patches; ++col_patch) {
+      const uint32_t patch = row_patch * col_patches + col_patch;
+      if (!dirty[patch]) {
+        continue;
+      }
+      const auto final_patch = updateBezierPatch(row_patch, col_patch);
+      for (uint32_t i = 0; i < 4; ++i) {
+        for (uint32_t j = 0; j < 4; ++j) {
+          const uint32_t offset = 3 * (4 * i + j);
+          patch_data[offset] = final_patch[i][j][0];
+          patch_data[offset + 1] = final_patch[i][j][1];
+          patch_data[offset + 2] = final_patch[i][j][2];
         }
       }
+      _mesh->updatePatch(patch, patch_data);
     }
   }
-  updateAlgebraicSurfaceC0();
 }
 
 std::unique_ptr<BezierSurfaceMesh> BezierSurfaceC2::generateMesh() {
@@ -72,7 +123,6 @@ BezierSurfaceC2::BezierSurfaceC2(
     point.get().surfacePoint() = true;
     subscribe(point);
   }
-  _polyMesh = createPolyMesh();
   _patches = {.colCount = uCount, .rowCount = vCount};
   _connectionType = connectionType;
   updateBezierSurface();
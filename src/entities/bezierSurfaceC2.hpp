@@ -38,10 +38,14 @@ private:
   std::vector<algebra::Vec3f> _rowOrderBezierControlPoints;
   std::vector<algebra::Vec3f> getRowOrderedBezierPoints() const;
   void updateAlgebraicSurfaceC0() override;
+  void updatePatches(const std::vector<uint32_t> &movedPoints) override;
 
   inline static int kClassId = 0;
 
   std::unique_ptr<BezierSurfaceMesh> generateMesh();
+  /// converts one patch's de Boor points into both Bezier point arrays
+  std::array<std::array<algebra::Vec3f, 4>, 4>
+  updateBezierPatch(uint32_t rowPatch, uint32_t colPatch);
   static std::array<std::array<algebra::Vec3f, 4>, 4>
   processPatch(const std::array<std::array<algebra::Vec3f, 4>, 4> &patch);
 };
\ No newline at end of file
@@ -1,6 +1,12 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <vector>
+
+class IEntity;
+
 enum class EntityType : uint8_t {
   Point,
   Torus,
@@ -14,4 +20,10 @@ enum class EntityType : uint8_t {
   GregorySurface,
   Polyline,
   IntersectionCurve
-};
\ No newline at end of file
+};
+
+inline constexpr size_t kEntityTypeCount =
+    static_cast<size_t>(EntityType::IntersectionCurve) + 1;
+
+/// entities of every type indexed by EntityType
+using EntityGroups = std::array<std::vector<IEntity *>, kEntityTypeCount>;
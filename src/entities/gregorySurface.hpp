@@ -27,18 +27,22 @@ public:
   }
   explicit GregorySurface(const std::array<BorderEdge, 3> &edges);
   std::array<MeshDensity, 3> &getMeshDensities() { return _meshDensities; }
+  const std::array<MeshDensity, 3> &getMeshDensities() const {
+    return _meshDensities;
+  }
   bool acceptVisitor(IVisitor &visitor) override {
     return visitor.visitGregorySurface(*this);
   };
   bool &showTangentVectors() { return _showTangentVectors; }
   const bool &showTangentVectors() const { return _showTangentVectors; }
 
-  void markToUpdate() override { _dirty = true; }
 
   void update() override {
     createGregoryPatches();
     updateMesh();
   }
+  /// after the surfaces around the hole it fills
+  int updateRank() const override { return 1; }
   void onSubscribableDestroyed(ISubscribable &publisher) override {
     _dead = true;
   }
@@ -9,7 +9,7 @@
 
 class PointEntity : public IEntity, public ISubscribable {
 public:
-  explicit PointEntity(algebra::Vec3f position) : _mesh(generateMesh()) {
+  explicit PointEntity(algebra::Vec3f position) : _mesh(sharedMesh()) {
     _id = kClassId++;
     _name = "Point_" + std::to_string(_id);
     _position = position;
@@ -68,7 +68,7 @@ public:
 
   const algebra::Vec3f &getPosition() const override { return _position; }
 
-  void updateMesh() override { _mesh = generateMesh(); };
+  void updateMesh() override { _mesh = sharedMesh(); };
   const Mesh &getMesh() const override { return *_mesh; }
   bool &surfacePoint() { return _surfacePoint; }
   bool surfacePoint() const { return _surfacePoint; }
@@ -101,10 +101,22 @@ public:
 
 private:
   inline static int kClassId;
-  std::unique_ptr<Mesh> _mesh;
+  std::shared_ptr<Mesh> _mesh;
   bool _surfacePoint = false;
 
-  std::unique_ptr<Mesh> generateMesh() {
+  /// Every point draws the same cube, so the GL objects are created once and
+  /// live as long as some point does.
+  static std::shared_ptr<Mesh> sharedMesh() {
+    static std::weak_ptr<Mesh> cube;
+    auto mesh = cube.lock();
+    if (!mesh) {
+      mesh = generateMesh();
+      cube = mesh;
+    }
+    return mesh;
+  }
+
+  static std::unique_ptr<Mesh> generateMesh() {
     std::vector<float> vertices = {// Front face
                                    -0.5f, -0.5f, 0.5f, 0.5f, -0.5f, 0.5f, 0.5f,
                                    0.5f, 0.5f, -0.5f, 0.5f, 0.5f,
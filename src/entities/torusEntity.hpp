@@ -5,6 +5,9 @@
 #include "mesh.hpp"
 #include "torus.hpp"
 #include "vec.hpp"
+#ifndef ARMCADILLO_HEADLESS
+#include "imgui.h"
+#endif
 #include <array>
 #include <string>
 
@@ -42,6 +45,9 @@ public:
   void updateMesh() override { mesh_ = generateMesh(); }
 
   bool renderSettings(const GUI &gui) override {
+#ifdef ARMCADILLO_HEADLESS
+    return false;
+#else
     IEntity::renderSettings(gui);
     bool change = false;
 
@@ -52,6 +58,7 @@ public:
     change |= ImGui::SliderInt("Vertical Density", &getMeshDensity().t, 3, 100);
 
     return change;
+#endif
   }
 
   std::array<algebra::Vec2f, 2> bounds() const override {
@@ -24,6 +24,7 @@ public:
 
   void updatePositionNoNotify(const algebra::Vec3f &position) {
     _position = position;
+    positionsChanged();
   }
 
   void updatePosition(const algebra::Vec3f &position) override;
@@ -5,6 +5,7 @@
 #include "bezierSurface.hpp"
 #include "bezierSurfaceC0.hpp"
 #include "bezierSurfaceRenderer.hpp"
+#include "binaryScene.hpp"
 #include "color.hpp"
 #include "cursor.hpp"
 #include "cursorController.hpp"
@@ -18,8 +19,10 @@
 #include "jsonSerializer.hpp"
 #include "modelController.hpp"
 #include "nfd.h"
+#include "nfd.hpp"
 #include "normalOffsetSurface.hpp"
 #include "pointEntity.hpp"
+#include "renderStats.hpp"
 #include "scene.hpp"
 #include "sceneRenderer.hpp"
 #include "selectionController.hpp"
@@ -28,8 +31,10 @@
 #include "virtualPoint.hpp"
 #include <algorithm>
 #include <cstdio>
+#include <filesystem>
 #include <functional>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -45,7 +50,9 @@ IController &GUI::getController() {
   return *_controllers[static_cast<int>(_selectedController)];
 }
 
-std::vector<IEntity *> GUI::getEntities() const { return _scene->getEntites(); }
+const std::vector<IEntity *> &GUI::getEntities() const {
+  return _scene->getEntites();
+}
 
 const std::vector<IEntity *> &GUI::getSelectedEntities() const {
   return _selectedEntities;
@@ -90,6 +97,7 @@ std::optional<const IRenderable *> GUI::getCenterPoint() {
 }
 
 void GUI::displayGUI() {
+  PROFILE_SCOPE("GUI::displayGUI");
   ImGuiWindowFlags window_flags =
       ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoCollapse |
       ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoNavFocus;
@@ -107,11 +115,13 @@ void GUI::displayGUI() {
 
     createEntityUI();
     findIntersectionUI();
+    displayTasksUI();
 
     removeButtonUI();
     contractEdgeUI();
 
     ImGui::Separator();
+    historyUI();
     createSerializeUI();
     createLoadSceneUI();
     ImGui::Separator();
@@ -122,9 +132,13 @@ void GUI::displayGUI() {
     ImGui::End();
   }
   pathCombinerGUI_.displayGUI(getCursor());
+  profilerWindow_.display();
+  updateHistory();
 }
 
 const Mouse &GUI::getMouse() { return _mouse; }
+bool GUI::gpuPicking() { return getSelectionController()->gpuPicking(); }
+
 PickingTexture &GUI::getPickingTexture() {
   return getSelectionController()->getPickingTexture();
 }
@@ -141,7 +155,8 @@ void GUI::initControllers() {
       std::make_unique<ModelController>(
           _centerPoint, getCursor(), _selectedEntities, *_scene->getCamera());
   _controllers[static_cast<int>(ControllerKind::Selection)] =
-      std::make_unique<SelectionController>(_window, _scene, _selectedEntities);
+      std::make_unique<SelectionController>(
+          _window, _scene, *_scene->getCamera(), _selectedEntities);
 }
 
 void GUI::renderModelControllSettings() {
@@ -180,9 +195,11 @@ void GUI::renderCursorControllerSettings() {
 }
 
 void GUI::removeButtonUI() {
+  ImGui::BeginDisabled(pathsBusy());
   if (ImGui::Button("Remove Entity")) {
     deleteSelectedEntities();
   }
+  ImGui::EndDisabled();
 }
 
 void GUI::createLoadSceneUI() {
@@ -193,8 +210,13 @@ void GUI::createLoadSceneUI() {
     nfdopendialogu8args_t args = {nullptr};
     nfdresult_t result = NFD_OpenDialogU8_With(&out_path, &args);
     if (result == NFD_OKAY) {
-      _jsonDeserializer.loadScence(std::string(out_path), *_scene);
+      const std::string path(out_path);
       NFD_FreePathU8(out_path);
+      if (BinaryScene::matches(path)) {
+        BinaryScene(path).load(*_scene);
+      } else {
+        _jsonDeserializer.loadScence(path, *_scene);
+      }
     }
     NFD_Quit();
   }
@@ -207,14 +229,59 @@ void GUI::createSerializeUI() {
     nfdsavedialogu8args_t args = {nullptr};
     nfdresult_t result = NFD_SaveDialogU8_With(&out_path, &args);
     if (result == NFD_OKAY) {
-      _jsonSerializer.getSavePath() = std::string(out_path);
+      const std::string path(out_path);
       NFD_FreePathU8(out_path);
-      _jsonSerializer.serializeScene(*_scene);
+      /// the binary format is picked by extension, JSON otherwise
+      if (path.ends_with(BinaryScene::kExtension)) {
+        BinaryScene::save(*_scene, path);
+      } else {
+        _jsonSerializer.getSavePath() = path;
+        _jsonSerializer.serializeScene(*_scene);
+      }
     }
     NFD_Quit();
   }
 }
 
+void GUI::historyUI() {
+  /// restoring removes and rebuilds entities running tasks may point to
+  const bool locked = pathsBusy() || intersectionBusy();
+  const bool shortcuts = !locked && !ImGui::GetIO().WantTextInput &&
+                         ImGui::IsKeyDown(ImGuiKey_LeftCtrl);
+
+  ImGui::BeginDisabled(locked || !history_.canUndo());
+  if (ImGui::Button("Undo") ||
+      (shortcuts && ImGui::IsKeyPressed(ImGuiKey_Z, false))) {
+    history_.undo(*_scene);
+    forgetRemovedEntities();
+  }
+  ImGui::EndDisabled();
+  ImGui::SameLine();
+  ImGui::BeginDisabled(locked || !history_.canRedo());
+  if (ImGui::Button("Redo") ||
+      (shortcuts && ImGui::IsKeyPressed(ImGuiKey_Y, false))) {
+    history_.redo(*_scene);
+    forgetRemovedEntities();
+  }
+  ImGui::EndDisabled();
+}
+
+void GUI::forgetRemovedEntities() {
+  std::erase_if(_selectedEntities,
+                [this](IEntity *entity) { return !_scene->contains(entity); });
+  /// owned by B-spline curves, which may have been rebuilt
+  clearVirtualPoints();
+  pathsGenerator_.forgetRemoved(*_scene);
+}
+
+void GUI::updateHistory() {
+  /// a drag or a slider held down becomes one step once released
+  const bool editing = ImGui::IsAnyMouseDown() || ImGui::IsAnyItemActive();
+  if (history_.update(*_scene, editing)) {
+    autosave_.submit(history_.current());
+  }
+}
+
 void GUI::renderModelSettings() {
   if (_selectedEntities.size() != 1) {
     return;
@@ -222,13 +289,15 @@ void GUI::renderModelSettings() {
 
   clearVirtualPoints();
   auto *selected_entity = *_selectedEntities.begin();
+  ImGui::BeginDisabled(pathsBusy());
   if (selected_entity->acceptVisitor(_guiSettingsVisitor)) {
     selected_entity->updateMesh();
   }
+  ImGui::EndDisabled();
 }
 
 void GUI::displayEntitiesList() {
-  auto entities = _scene->getEntites();
+  const auto &entities = _scene->getEntites();
   if (entities.empty()) {
     return;
   }
@@ -278,7 +347,7 @@ void GUI::deleteSelectedEntities() {
   clearSelectedEntities();
 
   _scene->removeEntities(dead_entities);
-  // clearSelectedEntities();
+  forgetRemovedEntities();
 }
 
 void GUI::clearSelectedEntities() {
@@ -304,6 +373,12 @@ void GUI::calculateFPS() {
 void GUI::showFPSCounter() {
   calculateFPS();
   ImGui::Text("FPS: %.1f", _fps);
+
+  const auto &stats = RenderStats::instance().lastFrame();
+  ImGui::Text("Draw calls: %u, programs: %u, vertex arrays: %u",
+              stats.drawCalls_, stats.programBinds_, stats.vertexArrayBinds_);
+  ImGui::Text("Uniforms: %u, buffer uploads: %u", stats.uniformUpdates_,
+              stats.bufferUploads_);
 }
 
 ModelController *GUI::getModelController() {
@@ -349,8 +424,11 @@ std::vector<IController *> GUI::getActiveControllers() {
   // active_controllers.push_back(
   //   _controllers[static_cast<int>(ControllerKind::Selection)]);
 
-  active_controllers.push_back(
-      _controllers[static_cast<int>(ControllerKind::Model)].get());
+  /// dragging moves points the path tasks read
+  if (!pathsBusy()) {
+    active_controllers.push_back(
+        _controllers[static_cast<int>(ControllerKind::Model)].get());
+  }
 
   return active_controllers;
 }
@@ -458,9 +536,11 @@ void GUI::contractSelectedEdge() {
 }
 
 void GUI::contractEdgeUI() {
+  ImGui::BeginDisabled(pathsBusy());
   if (ImGui::Button("Contract Selected Edge")) {
     contractSelectedEdge();
   }
+  ImGui::EndDisabled();
 }
 
 std::vector<std::reference_wrapper<BezierSurfaceC0>>
@@ -477,49 +557,102 @@ GUI::getSelectedSurfacesC0() const {
 }
 
 void GUI::findIntersectionUI() {
+  ImGui::BeginDisabled(intersectionBusy() || pathsBusy());
   if (ImGui::Button("Find intersections")) {
     findIntersection();
   }
-  _intersectionFinder.getIntersectionConfig().display();
+  ImGui::EndDisabled();
+  intersectionSettingsUI();
+}
+
+void GUI::intersectionSettingsUI() {
+  auto &config = _intersectionFinder.getIntersectionConfig();
+  if (ImGui::Begin("Intersection Settings")) {
+    ImGui::Checkbox("Use cursor", &config.useCursor_);
+    ImGui::SliderFloat("Numerical step", &config.numericalStep_,
+                       IntersectionConfig::kNumericalStepMin,
+                       IntersectionConfig::kNumericalStepMax, "%.4f");
+    ImGui::SliderFloat("Intersection step", &config.intersectionStep_,
+                       IntersectionConfig::kIntersectionStepMin,
+                       IntersectionConfig::kIntersectionStepMax, "%.4f");
+
+    ImGui::Checkbox("Use offset surface", &config.useOffsetSurface_);
+
+    ImGui::BeginDisabled(!config.useOffsetSurface_);
+    ImGui::InputFloat("Offset value", &config.offsetValue_);
+    ImGui::EndDisabled();
+  }
+  ImGui::End();
 }
+
+/// Tracing runs on a worker with its own copy of the finder and of the
+/// surfaces, so the selected entities may be edited or removed meanwhile.
+/// The curve and its textures are created on the main thread once it is
+/// found.
 void GUI::findIntersection() {
   auto entities = getSelectedEntities();
   if (entities.size() == 0) {
     return;
   }
 
-  auto *surf0 =
-      dynamic_cast<algebra::IDifferentialParametricForm<2, 3> *>(entities[0]);
+  const bool same = entities.size() == 1;
+  auto *entity_0 = entities[0];
+  auto *entity_1 = same ? entities[0] : entities[1];
 
-  auto *surf1 =
-      entities.size() == 1
-          ? surf0
-          : dynamic_cast<algebra::IDifferentialParametricForm<2, 3> *>(
-                entities[1]);
-
-  auto *bezier_surface_0 = dynamic_cast<BezierSurface *>(surf0);
-  auto *bezier_surface_1 = dynamic_cast<BezierSurface *>(surf1);
-
-  const auto offset_value =
-      _intersectionFinder.getIntersectionConfig().offsetValue_;
-  auto surf_0_offset = std::make_unique<algebra::NormalOffsetSurface>(
-      &bezier_surface_0->getAlgebraSurfaceC0(), offset_value);
-  auto surf_1_offset = std::make_unique<algebra::NormalOffsetSurface>(
-      &bezier_surface_1->getAlgebraSurfaceC0(), offset_value);
-  if (_intersectionFinder.getIntersectionConfig().useOffsetSurface_) {
-    _intersectionFinder.setSurfaces(surf_0_offset.get(), surf_1_offset.get());
-  } else {
-    _intersectionFinder.setSurfaces(surf0, surf1);
-  }
-  if (_intersectionFinder.getIntersectionConfig().useCursor_) {
-    _intersectionFinder.setGuidancePoint(getCursorPosition());
+  auto *bezier_surface_0 = dynamic_cast<BezierSurface *>(entity_0);
+  auto *bezier_surface_1 = dynamic_cast<BezierSurface *>(entity_1);
+  if (!bezier_surface_0 || !bezier_surface_1) {
+    return;
   }
 
-  auto intersection = _intersectionFinder.find(entities.size() == 1);
-  if (!intersection) {
+  auto surf0 = std::make_shared<algebra::BezierSurfaceC0>(
+      bezier_surface_0->getAlgebraSurfaceC0());
+  auto surf1 = same ? surf0
+                    : std::make_shared<algebra::BezierSurfaceC0>(
+                          bezier_surface_1->getAlgebraSurfaceC0());
+
+  auto finder = _intersectionFinder;
+  const auto &config = finder.getIntersectionConfig();
+  auto surf_0_offset = std::make_shared<algebra::NormalOffsetSurface>(
+      surf0.get(), config.offsetValue_);
+  auto surf_1_offset = std::make_shared<algebra::NormalOffsetSurface>(
+      surf1.get(), config.offsetValue_);
+  if (config.useOffsetSurface_) {
+    finder.setSurfaces(surf_0_offset.get(), surf_1_offset.get());
+  } else {
+    finder.setSurfaces(surf0.get(), surf1.get());
+  }
+  if (config.useCursor_) {
+    finder.setGuidancePoint(getCursorPosition());
+  }
+
+  intersectionTask_ = taskExecutor_.submit(
+      "Find intersection",
+      [finder = std::move(finder), same,
+       surfaces = std::pair{surf0, surf1},
+       offsets = std::pair{surf_0_offset, surf_1_offset}](Task &task) mutable {
+        finder.setProgress(&task.context());
+        return finder.find(same);
+      },
+      [this, entity_0, entity_1](std::optional<Intersection> intersection) {
+        if (intersection) {
+          addIntersectionCurve(*intersection, entity_0, entity_1);
+        }
+      });
+}
+
+void GUI::addIntersectionCurve(const Intersection &intersection,
+                               IEntity *entity0, IEntity *entity1) {
+  /// either surface might have been removed while tracing
+  if (!_scene->contains(entity0) || !_scene->contains(entity1)) {
     return;
   }
 
+  auto *surf0 =
+      dynamic_cast<algebra::IDifferentialParametricForm<2, 3> *>(entity0);
+  auto *surf1 =
+      dynamic_cast<algebra::IDifferentialParametricForm<2, 3> *>(entity1);
+
   auto bounds1 = surf0->bounds();
   auto bounds2 = surf1->bounds();
   auto bounds =
@@ -527,14 +660,12 @@ void GUI::findIntersection() {
           bounds1, bounds2);
 
   auto intersection_curve = std::make_unique<IntersectionCurve>(
-      *intersection, bounds, intersection->looped);
+      intersection, bounds, intersection.looped);
 
-  intersection_curve->setFirstPoint(intersection->firstPoint);
+  intersection_curve->setFirstPoint(intersection.firstPoint);
 
-  auto *surface_0_intersection = dynamic_cast<Intersectable *>(entities[0]);
-  auto *surface_1_intersection =
-      entities.size() == 1 ? surface_0_intersection
-                           : dynamic_cast<Intersectable *>(entities[1]);
+  auto *surface_0_intersection = dynamic_cast<Intersectable *>(entity0);
+  auto *surface_1_intersection = dynamic_cast<Intersectable *>(entity1);
 
   intersection_curve->getFirstTexture().setWrapping(surf0->wrapped(0),
                                                     surf0->wrapped(1));
@@ -578,13 +709,33 @@ void GUI::createEntityUI() {
 
 void GUI::renderPathGeneratorUI() {
   ImGui::Begin("Path generation");
+  /// the generator's state belongs to the worker until the task finishes,
+  /// a finishing trace writes the intersection textures paths are cut by
+  const bool paths_busy = pathsBusy();
+  const bool generation_blocked = paths_busy || intersectionBusy();
+  ImGui::BeginDisabled(generation_blocked);
   if (ImGui::Button("set selected surfaces as model")) {
     pathsGenerator_.setModel(getSelectedSurfaces());
   }
 
+  auto tool_diameter = [](const char *label, Cutter &cutter) {
+    ImGui::InputFloat(label, &cutter.diameter_, 0.1f, 0.5f, "%.1f");
+    cutter.diameter_ = std::max(cutter.diameter_, 0.1f);
+  };
+  tool_diameter("Roughing cutter [cm]", pathsGenerator_.roughingTool().cutter_);
+  tool_diameter("Flat cutter [cm]", pathsGenerator_.flatTool().cutter_);
+  tool_diameter("Detailed cutter [cm]", pathsGenerator_.detailedCutter());
+
   if (ImGui::Button("Generate Paths")) {
-    pathsGenerator_.run();
+    startPathsTask("Generate paths", [this](Task &task) {
+      pathsGenerator_.run(&task.context());
+    });
+  }
+  ImGui::SameLine();
+  if (ImGui::Button("Clear path cache")) {
+    pathsGenerator_.invalidate();
   }
+  ImGui::EndDisabled();
 
   static bool show_height_map_texture = false;
 
@@ -599,14 +750,84 @@ void GUI::renderPathGeneratorUI() {
     ImGui::End();
   };
 
-  ImGui::BeginDisabled(pathsGenerator_.heightMap() == nullptr);
+  ImGui::BeginDisabled(paths_busy || pathsGenerator_.heightMap() == nullptr);
   ImGui::Checkbox("Show heightMap Texture", &show_height_map_texture);
-  if (show_height_map_texture) {
+  if (show_height_map_texture && !paths_busy &&
+      pathsGenerator_.heightMap() != nullptr) {
     render_texture_window("heightMap",
                           pathsGenerator_.heightMap()->textureId());
   }
   ImGui::EndDisabled();
 
+  ImGui::BeginDisabled(paths_busy);
+  if (ImGui::Button("Simulate G-code files")) {
+    NFD::Init();
+    NFD::UniquePathSet paths;
+    if (NFD::OpenDialogMultiple(paths) == NFD_OKAY) {
+      nfdpathsetsize_t count = 0;
+      NFD::PathSet::Count(paths, count);
+
+      std::vector<std::filesystem::path> filepaths;
+      NFD::UniquePathSetPathN path;
+      for (nfdpathsetsize_t i = 0; i < count; ++i) {
+        NFD::PathSet::GetPath(paths, i, path);
+        filepaths.emplace_back(path.get());
+      }
+      pathsGenerator_.simulate(std::move(filepaths));
+    }
+    NFD::Quit();
+  }
+  ImGui::EndDisabled();
+
+  if (auto *simulation = pathsGenerator_.simulation()) {
+    ImGui::Checkbox("Show stock", &showStock_);
+    ImGui::Checkbox("Play", &simulation->playing());
+    ImGui::SameLine();
+    if (ImGui::Button("Finish")) {
+      simulation->finish();
+    }
+    ImGui::InputFloat("Feed [cm/s]", &simulation->speed(), 1.f, 10.f);
+    ImGui::ProgressBar(simulation->progress());
+
+    /// wall time drives the playback, long frames are capped so a slow
+    /// frame does not snowball into a longer one
+    simulation->advance(
+        std::min(ImGui::GetIO().DeltaTime, kMaxSimulationStep));
+
+    const auto &reports = simulation->reports();
+    for (std::size_t i = 0; i < reports.size(); ++i) {
+      const auto &report = reports[i];
+      ImGui::Text("%s: %zu moves, %zu gouging, %zu shank collisions",
+                  simulation->jobs()[i].name_.c_str(), report.moves,
+                  report.gougingMoves.size(), report.collidingMoves.size());
+      ImGui::Text("  %zu gouged pixels, max gouge %.4f",
+                  report.gouges.gougedPixels, report.gouges.maxGouge);
+    }
+
+    ImGui::BeginDisabled(paths_busy || !simulation->finished() ||
+                         pathsGenerator_.heightMap() == nullptr);
+    if (ImGui::Button("Analyze finish")) {
+      pathsGenerator_.analyzeFinish();
+    }
+    ImGui::EndDisabled();
+
+    if (const auto &summary = pathsGenerator_.finishSummary()) {
+      ImGui::Text("Residual max %.4f rms %.4f", summary->residual.max,
+                  summary->residual.rms);
+      ImGui::Text("Gouge max %.4f over %zu pixels", summary->gouge.max,
+                  summary->gouge.pixelsOverTolerance);
+    }
+  }
+
+  static bool show_finish_texture = false;
+  ImGui::BeginDisabled(pathsGenerator_.finishTexture() == nullptr);
+  ImGui::Checkbox("Show finish Texture", &show_finish_texture);
+  if (show_finish_texture && pathsGenerator_.finishTexture() != nullptr) {
+    render_texture_window("finish",
+                          pathsGenerator_.finishTexture()->getTextureId());
+  }
+  ImGui::EndDisabled();
+
   /// ------ it should be removed later ---------------------------------
   auto &bezier_surface_renderer =
       sceneRenderer_->getEntityRenderer(EntityType::BezierSurfaceC0);
@@ -634,6 +855,7 @@ void GUI::renderPathGeneratorUI() {
   ////
   auto &detailed_path_generator = pathsGenerator_.getDetailedPathGenerator();
 
+  ImGui::BeginDisabled(generation_blocked);
   ImGui::InputInt("Lines", &detailed_path_generator.lines());
 
   auto &direction = detailed_path_generator.direction();
@@ -656,13 +878,21 @@ void GUI::renderPathGeneratorUI() {
     ImGui::EndCombo();
   }
 
+  ImGui::InputFloat("Chord tolerance",
+                    &detailed_path_generator.chordTolerance(), 0.0005f, 0.005f,
+                    "%.4f");
+  ImGui::Checkbox("Parallel surfaces", &detailed_path_generator.parallel());
+  ImGui::Checkbox("Emit arcs (G02/G03)", &pathsGenerator_.dialect().arcs_);
+
   if (ImGui::Button("generate detail path")) {
-    detailed_path_generator.generate();
+    startPathsTask("Generate detailed paths", [this](Task &task) {
+      pathsGenerator_.generateDetailed(&task.context());
+    });
   }
 
   if (ImGui::Button("intersection path")) {
     const auto &selected_entities = getSelectedEntities();
-    std::vector<IntersectionCurve *> selected_intersections;
+    std::vector<const IntersectionCurve *> selected_intersections;
     for (auto *entity : selected_entities) {
       if (auto *intersection_curve =
               dynamic_cast<IntersectionCurve *>(entity)) {
@@ -670,14 +900,58 @@ void GUI::renderPathGeneratorUI() {
       }
     }
 
-    for (const auto *inter_curve : selected_intersections) {
-      detailed_path_generator.generatePathForIntersectionCurve(*inter_curve);
-    }
+    startPathsTask("Generate intersection paths",
+                   [this, selected_intersections](Task &task) {
+                     pathsGenerator_.generateIntersectionPaths(
+                         selected_intersections, &task.context());
+                   });
   }
+  ImGui::EndDisabled();
 
   ImGui::End();
 }
 
+void GUI::startPathsTask(std::string name,
+                         std::function<void(Task &)> generate) {
+  pathsTask_ =
+      taskExecutor_.submit(std::move(name), std::move(generate),
+                           [this] { pathsGenerator_.uploadTextures(); });
+}
+
+void GUI::displayTasksUI() {
+  const Task *dismissed = nullptr;
+  for (const auto &task : taskExecutor_.tasks()) {
+    ImGui::PushID(task.get());
+    if (task->status() == Task::Status::Failed) {
+      ImGui::TextColored(ImVec4(1.f, 0.4f, 0.4f, 1.f), "%s failed: %s",
+                         task->name().c_str(), task->error().c_str());
+      ImGui::SameLine();
+      if (ImGui::SmallButton("Dismiss")) {
+        dismissed = task.get();
+      }
+    } else {
+      const auto &context = task->context();
+      ImGui::ProgressBar(context.fraction(), ImVec2(200.f, 0.f),
+                         task->name().c_str());
+      ImGui::SameLine();
+      if (const auto remaining = context.remainingSeconds()) {
+        ImGui::Text("%.0f s left", *remaining);
+        ImGui::SameLine();
+      }
+      ImGui::BeginDisabled(context.cancelled());
+      if (ImGui::SmallButton("Cancel")) {
+        task->cancel();
+      }
+      ImGui::EndDisabled();
+    }
+    ImGui::PopID();
+  }
+
+  if (dismissed != nullptr) {
+    taskExecutor_.dismiss(dismissed);
+  }
+}
+
 std::vector<BezierSurface *> GUI::getSelectedSurfaces() const {
   std::vector<BezierSurface *> surfaces;
 
@@ -697,4 +971,6 @@ void GUI::selectAllPointsUI() {
       selectEntity(point);
     }
   }
+  ImGui::SameLine();
+  ImGui::Checkbox("GPU picking", &getSelectionController()->gpuPicking());
 }
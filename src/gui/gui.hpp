@@ -1,6 +1,7 @@
 #pragma once
 
 #include "GuiVisitor.hpp"
+#include "autosave.hpp"
 #include "IController.hpp"
 #include "IEntity.hpp"
 #include "bezierSurface.hpp"
@@ -20,14 +21,19 @@
 #include "pathCombinerGui.hpp"
 #include "pathsGenerator.hpp"
 #include "pointEntity.hpp"
+#include "profilerWindow.hpp"
+#include "sceneHistory.hpp"
 #include "sceneRenderer.hpp"
+#include "stockSimulation.hpp"
 #include "selectionController.hpp"
+#include "taskExecutor.hpp"
 #include "utils.hpp"
 #include "vec.hpp"
 #include "virtualPoint.hpp"
 #include <chrono>
 #include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
 class BezierCurveC0;
@@ -43,7 +49,7 @@ public:
   GUI(GLFWwindow *window, Scene *scene);
   IController &getController();
 
-  std::vector<IEntity *> getEntities() const;
+  const std::vector<IEntity *> &getEntities() const;
   std::vector<std::reference_wrapper<PointEntity>> getPoints() const;
   const std::vector<IEntity *> &getSelectedEntities() const;
   std::vector<IEntity *> getSelectedPointsPointers() const;
@@ -61,6 +67,7 @@ public:
 
   const Mouse &getMouse();
   PickingTexture &getPickingTexture();
+  bool gpuPicking();
 
   void
   setVirtualPoints(const std::vector<VirtualPoint *> &virtualPoints,
@@ -80,6 +87,13 @@ public:
     return pathCombinerGUI_.getSelectedPaths();
   }
 
+  /// applies results of finished background tasks, call at frame start
+  void processCompletedTasks() { taskExecutor_.processCompletions(); }
+
+  StockSimulation *stockSimulation() {
+    return showStock_ ? pathsGenerator_.simulation() : nullptr;
+  }
+
 private:
   GLFWwindow *_window;
   Scene *_scene;
@@ -99,12 +113,24 @@ private:
   IntersectionFinder _intersectionFinder;
   EntityUtils entityUtils_;
   PathsGenerator pathsGenerator_;
+  ProfilerWindow profilerWindow_;
   PathCombinerGUI pathCombinerGUI_;
+  std::shared_ptr<Task> intersectionTask_;
+  std::shared_ptr<Task> pathsTask_;
+  SceneHistory history_;
+  Autosave autosave_{Autosave::defaultPath()};
 
   std::chrono::time_point<std::chrono::high_resolution_clock> _lastTime =
       std::chrono::high_resolution_clock::now();
   double _fps = 0.0;
   bool _stereographicVision = false;
+  bool showStock_ = true;
+  /// longest wall time [s] one frame may advance the stock simulation
+  static constexpr float kMaxSimulationStep = 0.1f;
+
+  /// declared last, destroying it first joins workers still using the
+  /// members above
+  TaskExecutor taskExecutor_;
 
   void initControllers();
   void processControllers();
@@ -116,9 +142,22 @@ private:
   void removeButtonUI();
   void createSerializeUI();
   void createLoadSceneUI();
+  void historyUI();
+  void updateHistory();
   void contractEdgeUI();
   void findIntersectionUI();
+  void intersectionSettingsUI();
   void findIntersection();
+  void addIntersectionCurve(const Intersection &intersection,
+                            IEntity *entity0, IEntity *entity1);
+  void displayTasksUI();
+  void startPathsTask(std::string name, std::function<void(Task &)> generate);
+  /// Path tasks read the model surfaces, their points and intersection
+  /// textures on a worker, so the scene is not edited until they finish.
+  bool pathsBusy() const { return pathsTask_ && !pathsTask_->finished(); }
+  bool intersectionBusy() const {
+    return intersectionTask_ && !intersectionTask_->finished();
+  }
   void renderPathGeneratorUI();
 
   void renderModelSettings();
@@ -126,6 +165,8 @@ private:
   void displayEntitiesList();
   void deleteSelectedEntities();
   void clearSelectedEntities();
+  /// drops what the GUI and the path generator keep of removed entities
+  void forgetRemovedEntities();
   void selectEntity(int entityIndex);
   void selectEntity(const IEntity &entity);
   void selectAllPointsUI();
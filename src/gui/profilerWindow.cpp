@@ -0,0 +1,181 @@
+#include "profilerWindow.hpp"
+#include "imgui.h"
+#include "profiler.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+constexpr double kNanosecondsPerMillisecond = 1e6;
+
+ImU32 scopeColor(const char *name) {
+  const auto hash = std::hash<std::string_view>{}(name);
+  return ImColor::HSV(static_cast<float>(hash % 360) / 360.f, 0.5f, 0.75f);
+}
+} // namespace
+
+void ProfilerWindow::display() {
+  if (!ImGui::Begin("Profiler")) {
+    ImGui::End();
+    return;
+  }
+
+  if (!ARMCADILLO_PROFILING) {
+    ImGui::TextUnformatted(
+        "Scopes are compiled out, configure with ARMCADILLO_PROFILE=ON");
+    ImGui::End();
+    return;
+  }
+
+  controls();
+
+  if (!paused_) {
+    threads_ = Profiler::instance().snapshot();
+    end_ = Profiler::instance().now();
+  }
+  const auto begin =
+      end_ - static_cast<int64_t>(rangeMilliseconds_ *
+                                  kNanosecondsPerMillisecond);
+
+  timeline(begin);
+  ImGui::Separator();
+  totals(begin);
+
+  ImGui::End();
+}
+
+void ProfilerWindow::controls() {
+  ImGui::Checkbox("Pause", &paused_);
+  ImGui::SameLine();
+  if (ImGui::Button("Clear")) {
+    Profiler::instance().clear();
+  }
+  ImGui::SameLine();
+  if (ImGui::Button("Export Chrome trace")) {
+    try {
+      Profiler::instance().writeChromeTrace("profile_trace.json");
+      exportError_.clear();
+    } catch (const std::exception &e) {
+      exportError_ = e.what();
+    }
+  }
+  if (!exportError_.empty()) {
+    ImGui::TextColored(ImVec4(1.f, 0.4f, 0.4f, 1.f), "Export failed: %s",
+                       exportError_.c_str());
+  }
+  ImGui::SliderFloat("Range [ms]", &rangeMilliseconds_, 1.f, 10000.f, "%.0f",
+                     ImGuiSliderFlags_Logarithmic);
+}
+
+void ProfilerWindow::timeline(int64_t begin) const {
+  auto *draw_list = ImGui::GetWindowDrawList();
+  const float width = std::max(ImGui::GetContentRegionAvail().x, 1.f);
+  const auto scale = width / static_cast<float>(end_ - begin);
+
+  for (const auto &thread : threads_) {
+    uint32_t depth = 0;
+    for (const auto &event : thread.events_) {
+      if (event.end_ >= begin) {
+        depth = std::max(depth, event.depth_ + 1);
+      }
+    }
+    if (depth == 0) {
+      continue;
+    }
+
+    ImGui::TextUnformatted(thread.name_.c_str());
+    const auto origin = ImGui::GetCursorScreenPos();
+    const ImVec2 band_size(width, kRowHeight * static_cast<float>(depth));
+    draw_list->PushClipRect(
+        origin, ImVec2(origin.x + band_size.x, origin.y + band_size.y), true);
+
+    for (const auto &event : thread.events_) {
+      if (event.end_ < begin) {
+        continue;
+      }
+
+      const ImVec2 min(
+          origin.x +
+              static_cast<float>(std::max(event.start_, begin) - begin) * scale,
+          origin.y + kRowHeight * static_cast<float>(event.depth_));
+      const ImVec2 max(
+          std::max(origin.x + static_cast<float>(event.end_ - begin) * scale,
+                   min.x + 1.f),
+          min.y + kRowHeight - 1.f);
+      draw_list->AddRectFilled(min, max, scopeColor(event.name_));
+      if (max.x - min.x > kMinLabelWidth) {
+        draw_list->AddText(ImVec2(min.x + 2.f, min.y + 1.f),
+                           IM_COL32(0, 0, 0, 255), event.name_);
+      }
+
+      if (ImGui::IsMouseHoveringRect(min, max)) {
+        ImGui::SetTooltip(
+            "%s\n%.3f ms", event.name_,
+            static_cast<double>(event.end_ - event.start_) /
+                kNanosecondsPerMillisecond);
+      }
+    }
+
+    draw_list->PopClipRect();
+    ImGui::Dummy(band_size);
+  }
+}
+
+void ProfilerWindow::totals(int64_t begin) const {
+  struct Total {
+    const char *name;
+    int64_t duration = 0;
+    int64_t longest = 0;
+    uint32_t count = 0;
+  };
+
+  std::unordered_map<std::string_view, Total> by_name;
+  for (const auto &thread : threads_) {
+    for (const auto &event : thread.events_) {
+      if (event.start_ < begin) {
+        continue;
+      }
+      auto &total = by_name[event.name_];
+      const auto duration = event.end_ - event.start_;
+      total.name = event.name_;
+      total.duration += duration;
+      total.longest = std::max(total.longest, duration);
+      total.count++;
+    }
+  }
+
+  std::vector<Total> sorted;
+  sorted.reserve(by_name.size());
+  for (const auto &[name, total] : by_name) {
+    sorted.push_back(total);
+  }
+  std::ranges::sort(sorted, std::greater{}, &Total::duration);
+
+  if (ImGui::BeginTable("Totals", 4,
+                        ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders)) {
+    ImGui::TableSetupColumn("Scope");
+    ImGui::TableSetupColumn("Total [ms]");
+    ImGui::TableSetupColumn("Max [ms]");
+    ImGui::TableSetupColumn("Calls");
+    ImGui::TableHeadersRow();
+
+    for (const auto &total : sorted) {
+      ImGui::TableNextRow();
+      ImGui::TableNextColumn();
+      ImGui::TextUnformatted(total.name);
+      ImGui::TableNextColumn();
+      ImGui::Text("%.3f", static_cast<double>(total.duration) /
+                              kNanosecondsPerMillisecond);
+      ImGui::TableNextColumn();
+      ImGui::Text("%.3f", static_cast<double>(total.longest) /
+                              kNanosecondsPerMillisecond);
+      ImGui::TableNextColumn();
+      ImGui::Text("%u", total.count);
+    }
+    ImGui::EndTable();
+  }
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "profiler.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// Timeline of recorded scopes, one band per thread with nested scopes
+/// stacked by depth, and per scope totals over the visible range.
+class ProfilerWindow {
+public:
+  void display();
+
+private:
+  static constexpr float kRowHeight = 18.f;
+  static constexpr float kMinLabelWidth = 40.f;
+
+  bool paused_ = false;
+  float rangeMilliseconds_ = 50.f;
+  int64_t end_ = 0;
+  std::vector<Profiler::Thread> threads_;
+  /// why the last trace export failed, empty after a successful one
+  std::string exportError_;
+
+  void controls();
+  void timeline(int64_t begin) const;
+  void totals(int64_t begin) const;
+};
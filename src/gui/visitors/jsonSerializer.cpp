@@ -27,8 +27,8 @@ void JsonSerializer::serializeScene(const Scene &scene) {
 
 void JsonSerializer::createSceneJson(const Scene &scene) {
   const auto &grouped_entities = scene.getGroupedEntities();
-  for (const auto &pair : grouped_entities) {
-    for (const auto &entity : pair.second) {
+  for (const auto &entities : grouped_entities) {
+    for (auto *entity : entities) {
       entity->acceptVisitor(*this);
     }
   }
@@ -3,6 +3,7 @@
 #include "functions.hpp"
 #include "gradientDescent.hpp"
 #include "newtonMethod.hpp"
+#include "profiler.hpp"
 #include "vec.hpp"
 #include <algorithm>
 #include <cstdio>
@@ -28,7 +29,14 @@ void IntersectionFinder::setGuidancePoint(const algebra::Vec3f &guidancePoint) {
   guidancePoint_ = guidancePoint;
 }
 
+void IntersectionFinder::throwIfCancelled() const {
+  if (progress_ != nullptr) {
+    progress_->throwIfCancelled();
+  }
+}
+
 std::optional<Intersection> IntersectionFinder::find(bool same) const {
+  PROFILE_SCOPE("IntersectionFinder::find");
   std::optional<IntersectionPoint> first_point = findFirstPoint(same);
   std::println("Starts looking for first point!");
   if (!first_point) {
@@ -56,6 +64,7 @@ IntersectionFinder::findFirstPointStochastic() const {
                                              surface0_->bounds()[0][1]);
 
   for (std::size_t stoch_try = 0; stoch_try <= kStochasticTries; ++stoch_try) {
+    throwIfCancelled();
     if (stoch_try > 0 && stoch_try % 100 == 0) {
       std::println("stochastic try {}", stoch_try);
     }
@@ -84,6 +93,7 @@ IntersectionFinder::findFirstPointSameStochastic() const {
   std::uniform_real_distribution<float> dist(surface0_->bounds()[0][0],
                                              surface0_->bounds()[0][1]);
   for (std::size_t stoch_try = 0; stoch_try < kStochasticTries; ++stoch_try) {
+    throwIfCancelled();
     const auto point0 = algebra::Vec2f(dist(gen), dist(gen));
     const auto point1 = algebra::Vec2f(dist(gen), dist(gen));
 
@@ -97,6 +107,7 @@ IntersectionFinder::findFirstPointSameStochastic() const {
 std::optional<IntersectionPoint>
 IntersectionFinder::findFirstPointWithGuidance() const {
   for (std::size_t stoch_try = 0; stoch_try < kStochasticTries; ++stoch_try) {
+    throwIfCancelled();
     if (stoch_try > 0 && stoch_try % 10 == 0) {
       config_.numericalStep_ *= 2.f;
     }
@@ -125,6 +136,7 @@ IntersectionFinder::findFirstPointSameWithGuidance() const {
   std::uniform_real_distribution<float> dist(surface0_->bounds()[0][0],
                                              surface0_->bounds()[0][1]);
   for (std::size_t stoch_try = 0; stoch_try < kStochasticTries; ++stoch_try) {
+    throwIfCancelled();
     auto point0 = findPointProjection(surface0_, *guidancePoint_);
     if (!point0) {
       continue;
@@ -150,6 +162,7 @@ IntersectionFinder::findCommonSurfacePoint(const algebra::Vec2f &start0,
   auto function = std::make_unique<algebra::SurfaceSurfaceL2DistanceSquared>(
       surface0_, surface1_);
   algebra::GradientDescent<4> gradient_descent(std::move(function));
+  gradient_descent.setProgress(progress_);
 
   gradient_descent.setLearningRate(config_.numericalStep_);
   gradient_descent.setStartingPoint(
@@ -188,6 +201,7 @@ IntersectionFinder::newtowRefinment(const IntersectionPoint &point) const {
   algebra::Vec4f starting_point{point.surface0[0], point.surface0[1],
                                 point.surface1[0], point.surface1[1]};
   algebra::NewtonMethod<4, 4> newton(std::move(function), starting_point);
+  newton.setProgress(progress_);
   // newton.setIterationCount(2);
 
   auto newton_result = newton.calculate();
@@ -228,6 +242,7 @@ std::optional<algebra::Vec2f> IntersectionFinder::findPointProjection(
     auto function = std::make_unique<algebra::SurfacePointL2DistanceSquared>(
         surface, surfacePoint);
     algebra::GradientDescent<2> gradient_descent(std::move(function));
+    gradient_descent.setProgress(progress_);
 
     gradient_descent.setStartingPoint(guess);
     auto result = *gradient_descent.calculate();
@@ -266,9 +281,17 @@ IntersectionFinder::getTangent(const IntersectionPoint &firstPoint) const {
 std::optional<Intersection>
 IntersectionFinder::findNextPoints(const IntersectionPoint &firstPoint,
                                    bool reversed) const {
+  PROFILE_SCOPE("IntersectionFinder::findNextPoints");
   std::vector<IntersectionPoint> points = {firstPoint};
 
   for (std::size_t i = 1; i < kMaxIntersectionCurvePoint; ++i) {
+    throwIfCancelled();
+    if (progress_ != nullptr) {
+      /// forward tracing fills the first half, an open curve traces back too
+      progress_->report((reversed ? 0.5f : 0.f) +
+                         0.5f * static_cast<float>(i) /
+                             static_cast<float>(kMaxIntersectionCurvePoint));
+    }
     auto next_point = nextIntersectionPoint(points.back(), reversed);
 
     if (i > 2 && intersectionLooped(Intersection{.points = points})) {
@@ -305,6 +328,7 @@ IntersectionFinder::nextIntersectionPoint(const IntersectionPoint &lastPoint,
       std::move(function),
       algebra::Vec4f(lastPoint.surface0[0], lastPoint.surface0[1],
                      lastPoint.surface1[0], lastPoint.surface1[1]));
+  newton.setProgress(progress_);
 
   const auto next_intersection = newton.calculate();
 
@@ -349,6 +373,7 @@ std::optional<Intersection> IntersectionFinder::connectFoundPoints(
 
 std::optional<IntersectionPoint>
 IntersectionFinder::findFirstPoint(bool same) const {
+  PROFILE_SCOPE("IntersectionFinder::findFirstPoint");
   if (same) {
     return config_.useCursor_ ? findFirstPointSameWithGuidance()
                               : findFirstPointSameStochastic();
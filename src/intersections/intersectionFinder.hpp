@@ -2,6 +2,7 @@
 
 #include "IDifferentialParametricForm.hpp"
 #include "intersectionConfig.hpp"
+#include "progress.hpp"
 #include "vec.hpp"
 
 #include <cstdint>
@@ -25,6 +26,11 @@ public:
   void setSurfaces(const algebra::IDifferentialParametricForm<2, 3> *surface0,
                    const algebra::IDifferentialParametricForm<2, 3> *surface1);
   void setGuidancePoint(const algebra::Vec3f &guidancePoint);
+  /// reports tracing progress and makes find() throw algebra::Cancelled
+  /// once the context gets cancelled, nullptr for untracked calls
+  void setProgress(algebra::ProgressContext *progress) {
+    progress_ = progress;
+  }
   std::optional<Intersection> find(bool same) const;
 
   IntersectionConfig &getIntersectionConfig() { return config_; }
@@ -33,6 +39,7 @@ private:
   const algebra::IDifferentialParametricForm<2, 3> *surface0_;
   const algebra::IDifferentialParametricForm<2, 3> *surface1_;
   std::optional<algebra::Vec3f> guidancePoint_;
+  algebra::ProgressContext *progress_ = nullptr;
   static constexpr std::size_t kStochasticTries = 300;
   static constexpr std::size_t kMaxIntersectionCurvePoint = 2000;
 
@@ -69,4 +76,5 @@ private:
 
   void fixIntersectionPointsEdges(std::vector<IntersectionPoint> &points) const;
   bool intersectionLooped(const Intersection &intersection) const;
+  void throwIfCancelled() const;
 };
\ No newline at end of file
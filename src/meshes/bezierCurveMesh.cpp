@@ -1,6 +1,8 @@
 #include "bezierCurveMesh.hpp"
 
+#ifndef ARMCADILLO_HEADLESS
 #include "glad/gl.h"
+#endif
 
 uint32_t BezierMesh::getVAO() const { return _vao; }
 uint32_t BezierMesh::getVBO() const { return _vbo; }
@@ -25,6 +27,7 @@ BezierMesh::createC2(const std::vector<algebra::Vec3f> &vertices) {
 }
 
 BezierMesh::~BezierMesh() {
+#ifndef ARMCADILLO_HEADLESS
   if (_vao > 0)
     glDeleteVertexArrays(1, &_vao);
   if (_vbo > 0)
@@ -33,6 +36,7 @@ BezierMesh::~BezierMesh() {
     glDeleteBuffers(1, &_ebo);
 
   _vao = _vbo = _ebo = 0;
+#endif
 }
 
 BezierMesh::BezierMesh(BezierMesh &&other) noexcept
@@ -45,9 +49,11 @@ BezierMesh::BezierMesh(BezierMesh &&other) noexcept
 
 BezierMesh &BezierMesh::operator=(BezierMesh &&other) noexcept {
   if (this != &other) {
+#ifndef ARMCADILLO_HEADLESS
     glDeleteVertexArrays(1, &_vao);
     glDeleteBuffers(1, &_vbo);
     glDeleteBuffers(1, &_ebo);
+#endif
 
     _vao = other._vao;
     _vbo = other._vbo;
@@ -67,6 +73,7 @@ BezierMesh::BezierMesh(const std::vector<algebra::Vec3f> &vertices)
 }
 
 void BezierMesh::addSimpleVertexLayout() {
+#ifndef ARMCADILLO_HEADLESS
   glBindVertexArray(_vao);
   glBindBuffer(GL_ARRAY_BUFFER, _vbo);
   glEnableVertexAttribArray(0);
@@ -83,9 +90,11 @@ void BezierMesh::addSimpleVertexLayout() {
                           (void *)(sizeof(int) + sizeof(float) * i * 3));
   }
   glBindVertexArray(0);
+#endif
 }
 
 void BezierMesh::initBuffers() {
+#ifndef ARMCADILLO_HEADLESS
   glGenVertexArrays(1, &_vao);
   glGenBuffers(1, &_vbo);
   glGenBuffers(1, &_ebo);
@@ -95,6 +104,7 @@ void BezierMesh::initBuffers() {
   glBindBuffer(GL_ARRAY_BUFFER, _vbo);
   glBufferData(GL_ARRAY_BUFFER, _bezierSegments.size() * sizeof(BezierVertex),
                _bezierSegments.data(), GL_STATIC_DRAW);
+#endif
 }
 
 std::vector<BezierVertex>
@@ -35,7 +35,7 @@ protected:
   explicit BezierMesh(const std::vector<algebra::Vec3f> &vertices);
 
 private:
-  uint32_t _vao, _vbo, _ebo;
+  uint32_t _vao = 0, _vbo = 0, _ebo = 0;
   std::vector<BezierVertex> _bezierSegments;
 
   void addSimpleVertexLayout();
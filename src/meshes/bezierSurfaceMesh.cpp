@@ -1,9 +1,14 @@
 #include "bezierSurfaceMesh.hpp"
 
+#ifndef ARMCADILLO_HEADLESS
 #include "glad/gl.h"
+#endif
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <sys/types.h>
 #include <vector>
 
@@ -30,7 +35,21 @@ BezierSurfaceMesh::createC2(const std::vector<float> &points,
   auto *bezierSurfaceMesh = new BezierSurfaceMesh(points, u_patches, v_patches);
   return std::unique_ptr<BezierSurfaceMesh>(bezierSurfaceMesh);
 }
+
+void BezierSurfaceMesh::updatePatch(uint32_t patch,
+                                    std::span<const float> controlPoints) {
+  const size_t first = patch * kPatchFloats;
+  std::ranges::copy(controlPoints, _controlPoints.begin() + first);
+#ifndef ARMCADILLO_HEADLESS
+  glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+  glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(float),
+                  controlPoints.size_bytes(), controlPoints.data());
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+#endif
+}
+
 BezierSurfaceMesh::~BezierSurfaceMesh() {
+#ifndef ARMCADILLO_HEADLESS
   if (_vao > 0)
     glDeleteVertexArrays(1, &_vao);
   if (_vbo > 0)
@@ -39,6 +58,7 @@ BezierSurfaceMesh::~BezierSurfaceMesh() {
     glDeleteBuffers(1, &_ebo);
 
   _vao = _vbo = _ebo = 0;
+#endif
 }
 
 BezierSurfaceMesh::BezierSurfaceMesh(BezierSurfaceMesh &&other) noexcept
@@ -52,9 +72,11 @@ BezierSurfaceMesh::BezierSurfaceMesh(BezierSurfaceMesh &&other) noexcept
 BezierSurfaceMesh &
 BezierSurfaceMesh::operator=(BezierSurfaceMesh &&other) noexcept {
   if (this != &other) {
+#ifndef ARMCADILLO_HEADLESS
     glDeleteVertexArrays(1, &_vao);
     glDeleteBuffers(1, &_vbo);
     glDeleteBuffers(1, &_ebo);
+#endif
 
     _vao = other._vao;
     _vbo = other._vbo;
@@ -74,6 +96,7 @@ BezierSurfaceMesh::BezierSurfaceMesh(const std::vector<float> &vertices,
 }
 
 void BezierSurfaceMesh::initBuffers() {
+#ifndef ARMCADILLO_HEADLESS
   glGenVertexArrays(1, &_vao);
   glGenBuffers(1, &_vbo);
   glGenBuffers(1, &_ebo);
@@ -82,10 +105,11 @@ void BezierSurfaceMesh::initBuffers() {
 
   glBindBuffer(GL_ARRAY_BUFFER, _vbo);
   glBufferData(GL_ARRAY_BUFFER, _controlPoints.size() * sizeof(float),
-               _controlPoints.data(), GL_STATIC_DRAW);
+               _controlPoints.data(), GL_DYNAMIC_DRAW);
   glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void *)0);
   glEnableVertexAttribArray(0);
   glBindVertexArray(0);
+#endif
 }
 
 std::vector<float>
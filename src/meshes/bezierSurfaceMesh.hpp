@@ -1,8 +1,10 @@
 #pragma once
 
 #include "IMeshable.hpp"
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <sys/types.h>
 #include <vector>
 
@@ -20,6 +22,12 @@ public:
   createC2(const std::vector<float> &points, uint32_t u_patches,
            uint32_t v_patches);
 
+  /// floats of one patch, 16 control points
+  static constexpr size_t kPatchFloats = 16 * 3;
+
+  /// rewrites one patch's control points in the existing buffer
+  void updatePatch(uint32_t patch, std::span<const float> controlPoints);
+
   ~BezierSurfaceMesh() override;
 
   BezierSurfaceMesh(BezierSurfaceMesh &&other) noexcept;
@@ -33,7 +41,7 @@ protected:
                              uint32_t u_patches, uint32_t v_patches);
 
 private:
-  uint32_t _vao, _vbo, _ebo; // these may need to be changed idk why?
+  uint32_t _vao = 0, _vbo = 0, _ebo = 0; // these may need to be changed idk why?
   std::vector<float> _controlPoints;
   void initBuffers();
 
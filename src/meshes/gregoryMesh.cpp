@@ -1,5 +1,7 @@
 #include "gregoryMesh.hpp"
+#ifndef ARMCADILLO_HEADLESS
 #include "glad/gl.h"
+#endif
 #include "gregoryQuad.hpp"
 #include <cstdint>
 #include <memory>
@@ -18,6 +20,7 @@ std::unique_ptr<GregoryMesh> GregoryMesh::create(const GregoryQuad &quad) {
 }
 
 GregoryMesh::~GregoryMesh() {
+#ifndef ARMCADILLO_HEADLESS
   if (_vao > 0)
     glDeleteVertexArrays(1, &_vao);
   if (_vbo > 0)
@@ -26,6 +29,7 @@ GregoryMesh::~GregoryMesh() {
     glDeleteBuffers(1, &_ebo);
 
   _vao = _vbo = _ebo = 0;
+#endif
 }
 
 GregoryMesh::GregoryMesh(GregoryMesh &&other) noexcept
@@ -38,9 +42,11 @@ GregoryMesh::GregoryMesh(GregoryMesh &&other) noexcept
 
 GregoryMesh &GregoryMesh::operator=(GregoryMesh &&other) noexcept {
   if (this != &other) {
+#ifndef ARMCADILLO_HEADLESS
     glDeleteVertexArrays(1, &_vao);
     glDeleteBuffers(1, &_vbo);
     glDeleteBuffers(1, &_ebo);
+#endif
 
     _vao = other._vao;
     _vbo = other._vbo;
@@ -59,6 +65,7 @@ GregoryMesh::GregoryMesh(const std::vector<float> &vertices)
 }
 
 void GregoryMesh::initBuffers() {
+#ifndef ARMCADILLO_HEADLESS
   glGenVertexArrays(1, &_vao);
   glGenBuffers(1, &_vbo);
   glGenBuffers(1, &_ebo);
@@ -71,6 +78,7 @@ void GregoryMesh::initBuffers() {
   glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void *)0);
   glEnableVertexAttribArray(0);
   glBindVertexArray(0);
+#endif
 }
 
 std::vector<float> GregoryMesh::createMeshData(const GregoryQuad &quad) {
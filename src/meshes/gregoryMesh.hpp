@@ -29,7 +29,7 @@ protected:
   explicit GregoryMesh(const std::vector<float> &vertices);
 
 private:
-  uint32_t _vao, _vbo, _ebo; // these may need to be changed idk why?
+  uint32_t _vao = 0, _vbo = 0, _ebo = 0; // these may need to be changed idk why?
   std::vector<float> _vertices;
   void initBuffers();
 
@@ -1,8 +1,13 @@
 
 #include "mesh.hpp"
 #include "IParametrizable.hpp"
+#ifndef ARMCADILLO_HEADLESS
 #include "glad/gl.h"
+#endif
+#include <algorithm>
+#include <cstddef>
 #include <memory>
+#include <span>
 #include <vector>
 
 uint32_t Mesh::getVAO() const { return _vao; }
@@ -41,6 +46,7 @@ std::unique_ptr<Mesh> Mesh::fromParametrizationTextured(
 }
 
 Mesh::~Mesh() {
+#ifndef ARMCADILLO_HEADLESS
   if (_vao > 0)
     glDeleteVertexArrays(1, &_vao);
   if (_vbo > 0)
@@ -49,6 +55,7 @@ Mesh::~Mesh() {
     glDeleteBuffers(1, &_ebo);
 
   _vao = _vbo = _ebo = 0;
+#endif
 }
 
 Mesh::Mesh(Mesh &&other) noexcept
@@ -62,9 +69,11 @@ Mesh::Mesh(Mesh &&other) noexcept
 
 Mesh &Mesh::operator=(Mesh &&other) noexcept {
   if (this != &other) {
+#ifndef ARMCADILLO_HEADLESS
     glDeleteVertexArrays(1, &_vao);
     glDeleteBuffers(1, &_vbo);
     glDeleteBuffers(1, &_ebo);
+#endif
 
     _vao = other._vao;
     _vbo = other._vbo;
@@ -79,6 +88,16 @@ Mesh &Mesh::operator=(Mesh &&other) noexcept {
   return *this;
 }
 
+void Mesh::updateVertices(size_t firstFloat, std::span<const float> vertices) {
+  std::ranges::copy(vertices, _vertices.begin() + firstFloat);
+#ifndef ARMCADILLO_HEADLESS
+  glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+  glBufferSubData(GL_ARRAY_BUFFER, firstFloat * sizeof(float),
+                  vertices.size_bytes(), vertices.data());
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+#endif
+}
+
 Mesh::Mesh(const std::vector<float> &vertices,
            const std::vector<uint32_t> &_indices)
     : _vertices(vertices), _indices(_indices) {
@@ -86,6 +105,7 @@ Mesh::Mesh(const std::vector<float> &vertices,
 }
 
 void Mesh::addSimpleVertexLayout() {
+#ifndef ARMCADILLO_HEADLESS
   glBindVertexArray(_vao);
   glBindBuffer(GL_ARRAY_BUFFER, _vbo);
 
@@ -94,8 +114,10 @@ void Mesh::addSimpleVertexLayout() {
 
   glBindBuffer(GL_ARRAY_BUFFER, 0);
   glBindVertexArray(0);
+#endif
 }
 void Mesh::addTextureLayout() {
+#ifndef ARMCADILLO_HEADLESS
   glBindVertexArray(_vao);
   glBindBuffer(GL_ARRAY_BUFFER, _vbo);
   glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void *)0);
@@ -107,9 +129,11 @@ void Mesh::addTextureLayout() {
 
   glBindBuffer(GL_ARRAY_BUFFER, 0);
   glBindVertexArray(0);
+#endif
 }
 
 void Mesh::initBuffers() {
+#ifndef ARMCADILLO_HEADLESS
   glGenVertexArrays(1, &_vao);
   glGenBuffers(1, &_vbo);
   glGenBuffers(1, &_ebo);
@@ -123,6 +147,7 @@ void Mesh::initBuffers() {
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo);
   glBufferData(GL_ELEMENT_ARRAY_BUFFER, _indices.size() * sizeof(uint32_t),
                _indices.data(), GL_STATIC_DRAW);
+#endif
 }
 
 std::vector<float>
@@ -1,7 +1,9 @@
 #pragma once
 #include "IMeshable.hpp"
 #include "IParametrizable.hpp"
+#include <cstddef>
 #include <memory>
+#include <span>
 #include <vector>
 
 struct MeshDensity {
@@ -30,6 +32,10 @@ public:
       const algebra::IParametrizable<float> &parametrizable,
       const MeshDensity &meshDensity);
 
+  /// overwrites vertex floats starting at firstFloat in place, the vertex
+  /// count stays the same
+  void updateVertices(size_t firstFloat, std::span<const float> vertices);
+
   ~Mesh();
 
   Mesh(Mesh &&other) noexcept;
@@ -44,7 +50,7 @@ protected:
        const std::vector<uint32_t> &_indices);
 
 private:
-  uint32_t _vao, _vbo, _ebo;
+  uint32_t _vao = 0, _vbo = 0, _ebo = 0;
   std::vector<float> _vertices;
   std::vector<uint32_t> _indices;
 
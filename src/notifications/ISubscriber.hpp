@@ -11,8 +11,17 @@ public:
   void unsubscribe(const ISubscribable &publisher);
   virtual void onSubscribableDestroyed(ISubscribable &publisher) = 0;
   virtual void update() = 0;
-  virtual void markToUpdate() = 0;
+  /// queues update() for the next Scene::processFrame, once however many
+  /// publishers changed
+  void markToUpdate();
+  /// queued updates run in increasing rank, an entity reading another
+  /// subscriber's result ranks above it
+  virtual int updateRank() const { return 0; }
 
 protected:
   mutable std::vector<std::reference_wrapper<ISubscribable>> _publishers;
+
+private:
+  friend class UpdateScheduler;
+  bool updateQueued_ = false;
 };
\ No newline at end of file
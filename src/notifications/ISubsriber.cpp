@@ -1,8 +1,10 @@
 #include "ISubscribable.hpp"
 #include "ISubscriber.hpp"
+#include "updateScheduler.hpp"
 #include <functional>
 
 ISubscriber::~ISubscriber() {
+  UpdateScheduler::instance().cancel(*this);
   for (auto &publisher : _publishers) {
     publisher.get().removeSubscriber(*this);
   }
@@ -14,7 +16,12 @@ void ISubscriber::subscribe(ISubscribable &publisher) {
 }
 
 void ISubscriber::unsubscribe(const ISubscribable &publisher) {
+  publisher.removeSubscriber(*this);
   std::erase_if(_publishers, [&publisher](const auto &ref) {
     return &ref.get() == &publisher;
   });
-}
\ No newline at end of file
+}
+
+void ISubscriber::markToUpdate() {
+  UpdateScheduler::instance().schedule(*this);
+}
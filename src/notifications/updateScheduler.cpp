@@ -0,0 +1,44 @@
+#include "updateScheduler.hpp"
+#include "ISubscriber.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+#include <vector>
+
+UpdateScheduler &UpdateScheduler::instance() {
+  static UpdateScheduler scheduler;
+  return scheduler;
+}
+
+void UpdateScheduler::schedule(ISubscriber &subscriber) {
+  if (subscriber.updateQueued_) {
+    return;
+  }
+  subscriber.updateQueued_ = true;
+  queue_.push_back(&subscriber);
+}
+
+void UpdateScheduler::cancel(const ISubscriber &subscriber) {
+  if (!subscriber.updateQueued_) {
+    return;
+  }
+  std::erase(queue_, &subscriber);
+  std::ranges::replace(batch_, &subscriber, nullptr);
+}
+
+void UpdateScheduler::flush() {
+  PROFILE_SCOPE("UpdateScheduler::flush");
+  batch_.swap(queue_);
+  std::ranges::stable_sort(batch_, {}, [](const ISubscriber *subscriber) {
+    return subscriber->updateRank();
+  });
+
+  for (auto *subscriber : batch_) {
+    /// cleared by cancel() when an earlier update destroyed it
+    if (subscriber == nullptr) {
+      continue;
+    }
+    subscriber->updateQueued_ = false;
+    subscriber->update();
+  }
+  batch_.clear();
+}
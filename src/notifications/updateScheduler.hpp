@@ -0,0 +1,23 @@
+#pragma once
+
+#include <vector>
+
+class ISubscriber;
+
+/// Coalesces change notifications into one update() per subscriber per
+/// flush. Subscribers marked while flushing wait for the next flush, so
+/// update cycles cannot stall a frame.
+class UpdateScheduler {
+public:
+  static UpdateScheduler &instance();
+
+  void schedule(ISubscriber &subscriber);
+  void cancel(const ISubscriber &subscriber);
+
+  /// runs queued updates ordered by ISubscriber::updateRank()
+  void flush();
+
+private:
+  std::vector<ISubscriber *> queue_;
+  std::vector<ISubscriber *> batch_;
+};
@@ -1,10 +1,22 @@
 #include "GCodeSerializer.hpp"
+#include "arcFitter.hpp"
+#include "plane.hpp"
+#include "toolMove.hpp"
 #include "vec.hpp"
+#include <format>
 #include <fstream>
+#include <optional>
 #include <ranges>
+#include <string>
 
 void GCodeSerializer::serializePath(const MillingPath &millingPath,
-                                    const std::filesystem::path &filename) {
+                                    const std::filesystem::path &filename,
+                                    const GCodeDialect &dialect) {
+  if (dialect.arcs_) {
+    serializeMoves(ArcFitter(dialect.arcTolerance_).fit(millingPath.points()),
+                   filename);
+    return;
+  }
 
   std::ofstream out(filename);
   if (!out) {
@@ -16,4 +28,49 @@ void GCodeSerializer::serializePath(const MillingPath &millingPath,
                        point.z() * 10.f,
                        point.y() * 10.f); /// we reverse y and z here
   }
-}
\ No newline at end of file
+}
+
+/// World XZ is the machine XY plane (G17), world XY the machine XZ plane
+/// (G18). G18 arcs turn in Z->X order, so their direction is mirrored with
+/// respect to the world x->y order the fitter reports.
+void GCodeSerializer::serializeMoves(const std::vector<ToolMove> &moves,
+                                     const std::filesystem::path &filename) {
+  std::ofstream out(filename);
+  if (!out) {
+    throw std::runtime_error("Failed to open file: " + filename.string());
+  }
+
+  std::optional<algebra::Plane> active_plane;
+  algebra::Vec3f previous;
+
+  for (const auto &[i, move] : moves | std::views::enumerate) {
+    const auto &end = move.end_;
+    const auto target = std::format("X{:.3f}Y{:.3f}Z{:.3f}", end.x() * 10.f,
+                                    end.z() * 10.f, end.y() * 10.f);
+
+    if (move.type_ == ToolMove::Type::Linear || i == 0) {
+      out << std::format("N{}G01{}\n", i, target);
+      previous = end;
+      continue;
+    }
+
+    const auto offset = (move.center_ - previous) * 10.f;
+    const bool g17 = move.plane_ == algebra::Plane::XZ;
+    const bool clockwise =
+        g17 ? !move.counterClockwise_ : move.counterClockwise_;
+
+    std::string plane_word;
+    if (active_plane != move.plane_) {
+      plane_word = g17 ? "G17" : "G18";
+      active_plane = move.plane_;
+    }
+
+    const auto center_words =
+        g17 ? std::format("I{:.3f}J{:.3f}", offset.x(), offset.z())
+            : std::format("I{:.3f}K{:.3f}", offset.x(), offset.y());
+
+    out << std::format("N{}{}{}{}{}\n", i, plane_word,
+                       clockwise ? "G02" : "G03", target, center_words);
+    previous = end;
+  }
+}
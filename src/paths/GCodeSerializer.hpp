@@ -1,12 +1,26 @@
 #pragma once
 
 #include "millingPath.hpp"
+#include "toolMove.hpp"
 #include <filesystem>
+#include <vector>
+
+/// Controller capabilities the emitted program may rely on.
+struct GCodeDialect {
+  /// fit circular arcs and emit them as G02/G03 (G17/G18 planes)
+  bool arcs_ = false;
+  /// max distance [cm] between a fitted arc and the points it replaces
+  float arcTolerance_ = 0.001f;
+};
 
 class GCodeSerializer {
 public:
   static void serializePath(const MillingPath &millingPath,
-                            const std::filesystem::path &filename);
+                            const std::filesystem::path &filename,
+                            const GCodeDialect &dialect = {});
+
+  static void serializeMoves(const std::vector<ToolMove> &moves,
+                             const std::filesystem::path &filename);
 
 private:
-};
\ No newline at end of file
+};
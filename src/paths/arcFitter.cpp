@@ -0,0 +1,251 @@
+#include "arcFitter.hpp"
+#include "plane.hpp"
+#include "toolMove.hpp"
+#include "vec.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace {
+/// in plane coordinates, third component is the plane's normal axis
+algebra::Vec3f toPlane(const algebra::Vec3f &p, algebra::Plane plane) {
+  switch (plane) {
+  case algebra::Plane::XY:
+    return {p.x(), p.y(), p.z()};
+  case algebra::Plane::XZ:
+    return {p.x(), p.z(), p.y()};
+  case algebra::Plane::YZ:
+    return {p.y(), p.z(), p.x()};
+  }
+  std::unreachable();
+}
+
+algebra::Vec3f fromPlane(const algebra::Vec3f &p, algebra::Plane plane) {
+  switch (plane) {
+  case algebra::Plane::XY:
+    return {p.x(), p.y(), p.z()};
+  case algebra::Plane::XZ:
+    return {p.x(), p.z(), p.y()};
+  case algebra::Plane::YZ:
+    return {p.z(), p.x(), p.y()};
+  }
+  std::unreachable();
+}
+
+float cross(float ax, float ay, float bx, float by) {
+  return ax * by - ay * bx;
+}
+} // namespace
+
+std::vector<ToolMove>
+ArcFitter::fit(const std::vector<algebra::Vec3f> &points) const {
+  std::vector<ToolMove> moves;
+  if (points.empty()) {
+    return moves;
+  }
+
+  moves.reserve(points.size());
+  moves.push_back(ToolMove::linear(points.front()));
+
+  size_t i = 0;
+  while (i + 1 < points.size()) {
+    std::optional<ToolMove> best;
+    size_t best_last = i;
+
+    for (const auto plane : {algebra::Plane::XZ, algebra::Plane::XY}) {
+      size_t last = i;
+      auto arc = longestArc(points, i, plane, last);
+      if (arc && last > best_last) {
+        best = arc;
+        best_last = last;
+      }
+    }
+
+    if (best) {
+      moves.push_back(*best);
+      i = best_last;
+    } else {
+      moves.push_back(ToolMove::linear(points[i + 1]));
+      ++i;
+    }
+  }
+
+  return moves;
+}
+
+/// Grows the run exponentially while it still fits an arc, then narrows the
+/// first failing length down by bisection.
+std::optional<ToolMove>
+ArcFitter::longestArc(const std::vector<algebra::Vec3f> &points, size_t first,
+                      algebra::Plane plane, size_t &last) const {
+  size_t good = first + kMinArcPoints - 1;
+  if (good >= points.size()) {
+    return std::nullopt;
+  }
+
+  auto arc = fitRun(points, first, good, plane);
+  if (!arc) {
+    return std::nullopt;
+  }
+
+  size_t bad = good;
+  while (good + 1 < points.size()) {
+    const size_t candidate =
+        std::min(first + 2 * (good - first), points.size() - 1);
+    auto candidate_arc = fitRun(points, first, candidate, plane);
+    if (!candidate_arc) {
+      bad = candidate;
+      break;
+    }
+    good = candidate;
+    arc = candidate_arc;
+  }
+
+  while (bad > good + 1) {
+    const size_t middle = good + (bad - good) / 2;
+    auto candidate_arc = fitRun(points, first, middle, plane);
+    if (candidate_arc) {
+      good = middle;
+      arc = candidate_arc;
+    } else {
+      bad = middle;
+    }
+  }
+
+  last = good;
+  return arc;
+}
+
+std::optional<ToolMove>
+ArcFitter::fitRun(const std::vector<algebra::Vec3f> &points, size_t first,
+                  size_t last, algebra::Plane plane) const {
+  const auto start = toPlane(points[first], plane);
+  const auto middle = toPlane(points[first + (last - first) / 2], plane);
+  const auto end = toPlane(points[last], plane);
+
+  for (size_t k = first + 1; k <= last; ++k) {
+    if (std::abs(toPlane(points[k], plane).z() - start.z()) > tolerance_) {
+      return std::nullopt;
+    }
+  }
+
+  /// circle through start, middle and end
+  const float d = 2.f * (start.x() * (middle.y() - end.y()) +
+                         middle.x() * (end.y() - start.y()) +
+                         end.x() * (start.y() - middle.y()));
+  if (std::abs(d) < 1e-9f) {
+    return std::nullopt;
+  }
+
+  auto squared = [](const algebra::Vec3f &p) {
+    return p.x() * p.x() + p.y() * p.y();
+  };
+  float cx = (squared(start) * (middle.y() - end.y()) +
+              squared(middle) * (end.y() - start.y()) +
+              squared(end) * (start.y() - middle.y())) /
+             d;
+  float cy = (squared(start) * (end.x() - middle.x()) +
+              squared(middle) * (start.x() - end.x()) +
+              squared(end) * (middle.x() - start.x())) /
+             d;
+
+  /// move the center onto the chord bisector so that start and end radii
+  /// agree exactly, controllers reject arcs whose radii differ
+  const float mx = (start.x() + end.x()) * 0.5f;
+  const float my = (start.y() + end.y()) * 0.5f;
+  float nx = -(end.y() - start.y());
+  float ny = end.x() - start.x();
+  const float n_length = std::sqrt(nx * nx + ny * ny);
+  if (n_length > 0.f) {
+    nx /= n_length;
+    ny /= n_length;
+    const float along = (cx - mx) * nx + (cy - my) * ny;
+    cx = mx + nx * along;
+    cy = my + ny * along;
+  }
+
+  const float radius = std::hypot(start.x() - cx, start.y() - cy);
+  if (radius > kMaxRadius) {
+    return std::nullopt;
+  }
+
+  float orientation = 0.f;
+  float sweep = 0.f;
+  for (size_t k = first; k < last; ++k) {
+    const auto a = toPlane(points[k], plane);
+    const auto b = toPlane(points[k + 1], plane);
+
+    if (std::abs(std::hypot(b.x() - cx, b.y() - cy) - radius) > tolerance_) {
+      return std::nullopt;
+    }
+
+    const float ax = a.x() - cx;
+    const float ay = a.y() - cy;
+    const float bx = b.x() - cx;
+    const float by = b.y() - cy;
+    const float turn = cross(ax, ay, bx, by);
+    if (turn == 0.f || turn * orientation < 0.f) {
+      return std::nullopt;
+    }
+    orientation = turn;
+
+    /// chord angle bounds both the sagitta and the tangent deviation
+    const float angle = std::atan2(std::abs(turn), ax * bx + ay * by);
+    if (angle > kMaxChordAngle ||
+        radius * (1.f - std::cos(angle * 0.5f)) > tolerance_) {
+      return std::nullopt;
+    }
+
+    sweep += angle;
+    if (sweep >= 2.f * std::numbers::pi_v<float> - kMaxChordAngle) {
+      return std::nullopt;
+    }
+  }
+
+  return ToolMove{.type_ = ToolMove::Type::Arc,
+                  .end_ = points[last],
+                  .center_ = fromPlane({cx, cy, start.z()}, plane),
+                  .plane_ = plane,
+                  .counterClockwise_ = orientation > 0.f};
+}
+
+std::vector<algebra::Vec3f> ArcFitter::tessellate(const algebra::Vec3f &start,
+                                                  const ToolMove &arc,
+                                                  float maxAngle) {
+  const auto s = toPlane(start, arc.plane_);
+  const auto e = toPlane(arc.end_, arc.plane_);
+  const auto c = toPlane(arc.center_, arc.plane_);
+
+  const float two_pi = 2.f * std::numbers::pi_v<float>;
+  const float start_angle = std::atan2(s.y() - c.y(), s.x() - c.x());
+  const float end_angle = std::atan2(e.y() - c.y(), e.x() - c.x());
+
+  float sweep = end_angle - start_angle;
+  if (arc.counterClockwise_) {
+    if (sweep <= 0.f) {
+      sweep += two_pi;
+    }
+  } else if (sweep >= 0.f) {
+    sweep -= two_pi;
+  }
+
+  const float radius = std::hypot(s.x() - c.x(), s.y() - c.y());
+  const auto steps =
+      std::max(1, static_cast<int>(std::ceil(std::abs(sweep) / maxAngle)));
+
+  std::vector<algebra::Vec3f> points;
+  points.reserve(steps);
+  for (int k = 1; k < steps; ++k) {
+    const float t = static_cast<float>(k) / static_cast<float>(steps);
+    const float angle = start_angle + sweep * t;
+    points.push_back(fromPlane({c.x() + radius * std::cos(angle),
+                                c.y() + radius * std::sin(angle),
+                                s.z() + (e.z() - s.z()) * t},
+                               arc.plane_));
+  }
+  points.push_back(arc.end_);
+  return points;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "plane.hpp"
+#include "toolMove.hpp"
+#include "vec.hpp"
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+/// Replaces runs of polyline points lying on a circle in the XZ or XY world
+/// plane with arc moves. Every point of a run stays within tolerance of the
+/// arc and neighbouring points subtend a small angle, so the arc follows the
+/// tangent of the polyline it replaces.
+class ArcFitter {
+public:
+  explicit ArcFitter(float tolerance) : tolerance_(tolerance) {}
+
+  std::vector<ToolMove> fit(const std::vector<algebra::Vec3f> &points) const;
+
+  /// points along the arc from start, excluding start, including arc end
+  static std::vector<algebra::Vec3f> tessellate(const algebra::Vec3f &start,
+                                                const ToolMove &arc,
+                                                float maxAngle);
+
+private:
+  static constexpr size_t kMinArcPoints = 4;
+  static constexpr float kMaxRadius = 50.f;
+  static constexpr float kMaxChordAngle = 0.26f;
+
+  float tolerance_;
+
+  std::optional<ToolMove> fitRun(const std::vector<algebra::Vec3f> &points,
+                                 size_t first, size_t last,
+                                 algebra::Plane plane) const;
+  std::optional<ToolMove>
+  longestArc(const std::vector<algebra::Vec3f> &points, size_t first,
+             algebra::Plane plane, size_t &last) const;
+};
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cmath>
+#include <string>
+
 struct Cutter {
   enum class Type : bool { Flat, Ball };
 
@@ -8,4 +11,11 @@ struct Cutter {
   float height_;
 
   float radius() const { return diameter_ / 2.f; }
-};
\ No newline at end of file
+
+  /// k16, f10, ... the form MillingPathReader::readCutter parses back
+  std::string fileExtension() const {
+    const auto millimetres = std::lround(diameter_ * 10.f);
+    return std::string(type_ == Type::Ball ? "k" : "f") +
+           (millimetres < 10 ? "0" : "") + std::to_string(millimetres);
+  }
+};
@@ -1,5 +1,6 @@
 #include "detailedPathGenerator.hpp"
 #include "bezierSurface.hpp"
+#include "floorClassifier.hpp"
 #include "intersectionTexture.hpp"
 #include "millingPath.hpp"
 #include "normalOffsetSurface.hpp"
@@ -7,13 +8,18 @@
 #include "rdp.hpp"
 #include "vec.hpp"
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <future>
 #include <limits>
+#include <memory>
+#include <optional>
 #include <print>
 #include <queue>
 #include <ranges>
 #include <stdexcept>
 #include <sys/types.h>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -21,42 +27,77 @@
 static constexpr float kFloorHeight = 0.f;
 static constexpr float kFloorHeightPath = 1.5f;
 
-void DetailedPathGenerator::generate() {
+void DetailedPathGenerator::generate(algebra::ProgressContext *progress) {
   /// This section assumes that every model surface has proper intersection
   /// texture and all sections that should be trimmed are set.
+  const auto &surfaces = model_->surfaces();
+
+  algebra::ProgressContext untracked;
+  auto &root = progress != nullptr ? *progress : untracked;
+  std::vector<std::unique_ptr<algebra::ProgressContext>> surface_progress;
+  surface_progress.reserve(surfaces.size());
+  for (size_t i = 0; i < surfaces.size(); ++i) {
+    surface_progress.push_back(std::make_unique<algebra::ProgressContext>(
+        root, 1.f / static_cast<float>(surfaces.size())));
+  }
 
-  for (auto *surface : model_->surfaces()) {
-    setFloorAsTrimmed(*surface);
+  auto generate_surface = [&](size_t index) {
+    surface_progress[index]->throwIfCancelled();
+    generateSurfacePath(*surfaces[index]);
+    surface_progress[index]->report(1.f);
+  };
 
-    auto segments = generateLineSegments(*surface);
-    auto surface_paths = generateSurfacePaths(*surface, segments);
-    auto path = combineSurfacePaths(surface_paths);
+  if (!parallel_ || surfaces.size() < 2) {
+    for (size_t i = 0; i < surfaces.size(); ++i) {
+      generate_surface(i);
+    }
+  } else {
+    /// Surfaces only share read-only state (height map, cutter), every one of
+    /// them writes its own intersection texture and its own G-code file.
+    const auto worker_count =
+        std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()),
+                         surfaces.size());
+    std::atomic<size_t> next_surface = 0;
+
+    std::vector<std::future<void>> workers;
+    workers.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+      workers.push_back(std::async(std::launch::async, [&] {
+        for (auto index = next_surface++; index < surfaces.size();
+             index = next_surface++) {
+          generate_surface(index);
+        }
+      }));
+    }
 
-    auto milling_path = MillingPath{path, cutter_};
-    GCodeSerializer::serializePath(milling_path, surface->getName() + ".k08");
+    for (auto &worker : workers) {
+      worker.get();
+    }
   }
 }
 
+void DetailedPathGenerator::generateSurfacePath(BezierSurface &surface) {
+  setFloorAsTrimmed(surface);
+
+  auto segments = generateLineSegments(surface);
+  auto surface_paths = generateSurfacePaths(surface, segments);
+  auto path = combineSurfacePaths(surface_paths);
+
+  auto milling_path = MillingPath{path, cutter_};
+  GCodeSerializer::serializePath(
+      milling_path, surface.getName() + "." + cutter_.fileExtension(),
+      dialect());
+}
+
 void DetailedPathGenerator::setFloorAsTrimmed(
     BezierSurface &intersectableSurface) const {
   auto &intersection_texture = *intersectableSurface.getIntersectionTexture();
 
-  auto size = intersection_texture.getSize();
-  auto offset_surface = algebra::NormalOffsetSurface(
-      &intersectableSurface.getAlgebraSurfaceC0(), cutter_.radius());
-
-  for (int y = 0; y < size.height; ++y) {
-    for (int x = 0; x < size.width; ++x) {
-      auto uv = intersection_texture.uv(x, y);
-      auto p = offset_surface.value(uv);
+  const FloorClassifier classifier(intersectableSurface.getAlgebraSurfaceC0(),
+                                   cutter_.radius(), kFloorHeight);
+  classifier.classify(intersection_texture);
 
-      if (p.y() < kFloorHeight + cutter_.radius()) {
-        intersection_texture.setCellType(x, y,
-                                         IntersectionTexture::CellType::Trim);
-      }
-    }
-  }
-  intersection_texture.update();
+  glUpdates_.push([&intersection_texture] { intersection_texture.update(); });
 }
 
 std::vector<std::vector<DetailedPathGenerator::Coord>>
@@ -281,33 +322,106 @@ DetailedPathGenerator::generateLinePoints(const BezierSurface &surface,
 
   Coord delta =
       start.y == end.y ? Coord{.x = 1, .y = 0} : Coord{.x = 0, .y = 1};
+  const int count = (end.x - start.x) + (end.y - start.y);
+
+  /// Milled point and safe height of every texel on the line, filled on
+  /// first use so a footprint is scanned once however often chords over it
+  /// are retried.
+  struct Sample {
+    algebra::Vec3f point;
+    float safeHeight;
+  };
+  std::vector<std::optional<Sample>> samples(count + 1);
+  auto sample_at = [&](int index) -> const Sample & {
+    auto &sample = samples[index];
+    if (!sample) {
+      auto uv =
+          texture.uv(start.x + delta.x * index, start.y + delta.y * index);
+      auto offset_point = offset_surface.value(uv);
+      offset_point.y() += kFloorHeightPath - cutter_.radius();
+      const auto safe_height = safeHeight(offset_point);
+      fixPoint(offset_point, safe_height);
+      sample = Sample{.point = offset_point, .safeHeight = safe_height};
+    }
+    return *sample;
+  };
+  auto point_at = [&](int index) { return sample_at(index).point; };
+
+  /// Distance of the line between samples a and b from the milled points
+  /// inside, probed at quarter points.
+  auto chord_height = [&](int a, const algebra::Vec3f &pa, int b,
+                          const algebra::Vec3f &pb) {
+    const auto ab = pb - pa;
+    const auto ab_squared = ab.dot(ab);
+    float height = 0.f;
+
+    for (int q = 1; q < 4; ++q) {
+      const int index = a + (b - a) * q / 4;
+      if (index <= a || index >= b) {
+        continue;
+      }
+      const auto p = point_at(index);
+      const auto t =
+          ab_squared > 0.f ? std::clamp((p - pa).dot(ab) / ab_squared, 0.f, 1.f)
+                           : 0.f;
+      height = std::max(height, (pa + ab * t - p).length());
+    }
+    return height;
+  };
 
-  Coord current_coord{.x = start.x, .y = start.y};
-  while (current_coord != end) {
-    auto uv = texture.uv(current_coord.x, current_coord.y);
-    auto offset_point = offset_surface.value(uv);
-    offset_point.y() += kFloorHeightPath - cutter_.radius();
-    points.emplace_back(offset_point);
+  /// Whether the straight move between samples a and b cuts into the height
+  /// map at any texel skipped between them, compared against the safe
+  /// height profile of those texels.
+  auto chord_gouges = [&](int a, const algebra::Vec3f &pa, int b,
+                          const algebra::Vec3f &pb) {
+    for (int i = a + 1; i < b; ++i) {
+      const auto t = static_cast<float>(i - a) / static_cast<float>(b - a);
+      if (gouges(pa + (pb - pa) * t, sample_at(i).safeHeight)) {
+        return true;
+      }
+    }
+    return false;
+  };
 
-    current_coord.x += delta.x;
-    current_coord.y += delta.y;
-  }
+  /// March along the line: the step is predicted from the curvature implied
+  /// by the last chord (h ~ k * L^2 / 8) and halved until the chord height
+  /// fits the tolerance and the chord clears the height map.
+  int index = 0;
+  int step = kMaxSampleStep;
+  auto current = point_at(0);
+  points.push_back(current);
+
+  while (index < count) {
+    step = std::clamp(step, 1, count - index);
+
+    auto next = point_at(index + step);
+    auto height = chord_height(index, current, index + step, next);
+    while (step > 1 &&
+           (height > chordTolerance_ ||
+            chord_gouges(index, current, index + step, next))) {
+      step /= 2;
+      next = point_at(index + step);
+      height = chord_height(index, current, index + step, next);
+    }
+
+    points.push_back(next);
+    index += step;
+    current = next;
 
-  /// last_point
-  auto uv = texture.uv(end.x, end.y);
-  auto offset_point = offset_surface.value(uv);
-  offset_point.y() += kFloorHeightPath - cutter_.radius();
-  points.emplace_back(offset_point);
+    if (height > 0.f) {
+      step = static_cast<int>(static_cast<float>(step) *
+                              std::sqrt(chordTolerance_ / height));
+    } else {
+      step *= 2;
+    }
+    step = std::clamp(step, 1, kMaxSampleStep);
+  }
 
   if (reversed) {
     std::ranges::reverse(points);
   }
 
-  fixIntersectionLine(points, surface);
-
-  algebra::Plane plane =
-      start.x == end.x ? algebra::Plane::YZ : algebra::Plane::XZ;
-  return points; // algebra::RDP::reducePoints(points, 10e-5, plane);
+  return points;
 }
 
 std::vector<algebra::Vec3f> DetailedPathGenerator::combineSurfacePaths(
@@ -351,8 +465,9 @@ void DetailedPathGenerator::generatePathForIntersectionCurve(
                     [](const auto &a, const auto &b) { return a.z() > b.z(); });
 
   auto milling_path = MillingPath{milling_points, cutter_};
-  GCodeSerializer::serializePath(milling_path,
-                                 intersectionCurve.getName() + ".k08");
+  GCodeSerializer::serializePath(
+      milling_path,
+      intersectionCurve.getName() + "." + cutter_.fileExtension(), dialect());
 }
 
 std::vector<DetailedPathGenerator::Coord>
@@ -519,32 +634,34 @@ std::vector<algebra::Vec3f> DetailedPathGenerator::safeConnectionBridge(
   return points;
 }
 
-void DetailedPathGenerator::fixIntersectionLine(
-    std::vector<algebra::Vec3f> &points, const BezierSurface &surface) const {
-  auto fix_point = [&](algebra::Vec3f &point) {
-    auto index = heightMap_->posToIndex(point);
-    auto normal = heightMap_->normalAtIndex(index);
-    auto safe_height = heightMap_->findMinimumSafeHeightForCut(point, cutter_);
-    const float kGougeTolerance = 0.05f;
-
-    if (std::isnan(safe_height)) {
-      return;
-    }
-    if (point.y() >= safe_height - 1.5f - kGougeTolerance) {
-      return;
-    }
+void DetailedPathGenerator::fixPoint(algebra::Vec3f &point) const {
+  fixPoint(point, safeHeight(point));
+}
 
-    std::println("point.y() == {}, safe_height == {}", point.y(),
-                 safe_height - 1.5f);
+void DetailedPathGenerator::fixPoint(algebra::Vec3f &point,
+                                     float safeHeight) const {
+  if (!gouges(point, safeHeight)) {
+    return;
+  }
 
-    auto dist = safe_height - point.y() - 1.5f;
+  std::println("point.y() == {}, safe_height == {}", point.y(), safeHeight);
 
-    point.y() = safe_height - 1.5f; // point + normal * (dist);
-    return;
-  };
+  point.y() = safeHeight; // point + normal * (dist);
+}
 
+float DetailedPathGenerator::safeHeight(const algebra::Vec3f &point) const {
+  return heightMap_->findMinimumSafeHeightForCut(point, cutter_) - 1.5f;
+}
+
+bool DetailedPathGenerator::gouges(const algebra::Vec3f &point,
+                                   float safeHeight) const {
+  return !std::isnan(safeHeight) && point.y() < safeHeight - kGougeTolerance;
+}
+
+void DetailedPathGenerator::fixIntersectionLine(
+    std::vector<algebra::Vec3f> &points, const BezierSurface &surface) const {
   for (auto &p : points) {
-    fix_point(p);
+    fixPoint(p);
   }
 };
 
@@ -7,8 +7,10 @@
 #include "intersectionCurve.hpp"
 #include "intersectionFinder.hpp"
 #include "intersectionTexture.hpp"
+#include "mainThreadQueue.hpp"
 #include "model.hpp"
 #include "normalOffsetSurface.hpp"
+#include "progress.hpp"
 #include "scene.hpp"
 #include "vec.hpp"
 #include <memory>
@@ -26,7 +28,11 @@ public:
 
   enum class Direction : uint8_t { Vertical, Horizontal };
 
-  void generate();
+  /// trimmed intersection textures are uploaded by uploadTextures(),
+  /// progress advances and cancellation is checked per surface
+  void generate(algebra::ProgressContext *progress = nullptr);
+  /// main thread only
+  void uploadTextures() { glUpdates_.process(); }
   void setModel(const Model *model) { model_ = model; }
   void setCutter(Cutter cutter) { cutter_ = cutter; }
   void setScene(Scene *scene) { scene_ = scene; }
@@ -34,6 +40,7 @@ public:
     intersectionFinder_ = intersectionFinder;
   }
   void setHeightMap(const HeightMap *heightMap) { heightMap_ = heightMap; }
+  void setDialect(const GCodeDialect *dialect) { dialect_ = dialect; }
 
   const std::vector<IntersectionCurve *> &intersections() const {
     return intersections_;
@@ -44,6 +51,8 @@ public:
 
   Direction &direction() { return direction_; }
   int &lines() { return lines_; }
+  bool &parallel() { return parallel_; }
+  float &chordTolerance() { return chordTolerance_; }
 
   void generatePathForIntersectionCurve(
       const IntersectionCurve &intersectionCurve) const;
@@ -55,10 +64,25 @@ private:
   std::vector<IntersectionCurve *> intersections_;
   IntersectionFinder *intersectionFinder_;
   const HeightMap *heightMap_;
+  const GCodeDialect *dialect_ = nullptr;
 
   int lines_ = 40;
   Direction direction_ = Direction::Vertical;
+  bool parallel_ = true;
+  /// max distance [cm] between emitted pass lines and the offset surface
+  float chordTolerance_ = 0.001f;
+  /// longest sampling step in texels, skipped texels are still checked for
+  /// gouges along the emitted chord
+  static constexpr int kMaxSampleStep = 64;
+  /// depth [cm] below the safe height still accepted as not gouging
+  static constexpr float kGougeTolerance = 0.05f;
 
+  /// texture uploads requested by surface workers
+  mutable MainThreadQueue glUpdates_;
+
+  GCodeDialect dialect() const { return dialect_ ? *dialect_ : GCodeDialect{}; }
+
+  void generateSurfacePath(BezierSurface &surface);
   void setFloorAsTrimmed(BezierSurface &intersectableSurface) const;
 
   std::vector<std::vector<Coord>> generateLineSegments(BezierSurface &surface);
@@ -83,6 +107,11 @@ private:
 
   bool intersects(Coord coord,
                   const IntersectionTexture &intersectionTexture) const;
+  /// lowest tool position [cm] at the point's footprint, NaN off the map
+  float safeHeight(const algebra::Vec3f &point) const;
+  bool gouges(const algebra::Vec3f &point, float safeHeight) const;
+  void fixPoint(algebra::Vec3f &point) const;
+  void fixPoint(algebra::Vec3f &point, float safeHeight) const;
   void fixIntersectionLine(std::vector<algebra::Vec3f> &points,
                            const BezierSurface &surface) const;
   std::vector<algebra::Vec3f>
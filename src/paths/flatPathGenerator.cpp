@@ -25,22 +25,30 @@ void FlatPathGenerator::setHeightMap(HeightMap *heightMap) {
   heightMap_ = heightMap;
 }
 
-MillingPath FlatPathGenerator::generate() {
-
-  auto boundary_indices = findBoundaryIndices();
+MillingPath FlatPathGenerator::generate(algebra::ProgressContext *progress) {
+  algebra::ProgressContext untracked;
+  auto &root = progress != nullptr ? *progress : untracked;
+
+  /// shares roughly follow the cost of each step, the rest is reported by
+  /// the caller once the path is done
+  algebra::ProgressContext boundary_progress(root, 0.3f);
+  auto boundary_indices = findBoundaryIndices(boundary_progress);
   contourPoints_ = findCutterPositionsFromBoundary(boundary_indices);
   paintBorder(contourPoints_, Color::Green());
-  removeSelfIntersections();
+  algebra::ProgressContext intersections_progress(root, 0.4f);
+  removeSelfIntersections(intersections_progress);
   paintBorder(contourPoints_, Color::Red());
   contourPoints_ =
       algebra::RDP::reducePoints(contourPoints_, kEpsilon, algebra::Plane::XZ);
-  auto segments = generateSegments();
+  algebra::ProgressContext segments_progress(root, 0.2f);
+  auto segments = generateSegments(segments_progress);
   auto local_paths = generatePaths(segments);
 
   return combineLocalPaths(local_paths);
 };
 
-std::vector<uint32_t> FlatPathGenerator::findBoundaryIndices() {
+std::vector<uint32_t>
+FlatPathGenerator::findBoundaryIndices(algebra::ProgressContext &progress) {
   std::vector<bool> is_border(heightMap_->data_.size(), false);
   size_t border_size = 0;
   std::vector<uint32_t> border;
@@ -49,6 +57,8 @@ std::vector<uint32_t> FlatPathGenerator::findBoundaryIndices() {
   };
 
   for (size_t x = 0; x < heightMap_->divisions().x_; ++x) {
+    progress.poll(static_cast<float>(x) /
+                  static_cast<float>(heightMap_->divisions().x_));
     for (size_t z = 0; z < heightMap_->divisions().z_; ++z) {
 
       if (is_floor(x, z)) {
@@ -205,7 +215,6 @@ void FlatPathGenerator::paintBorderRed(
   heightMap_->textureData_[4 * index] = 0;
   heightMap_->textureData_[4 * index + 1] = 255;
   heightMap_->textureData_[4 * index + 2] = 0;
-  heightMap_->texture_->fill(heightMap_->textureData_);
 }
 
 void FlatPathGenerator::paintBorder(const std::vector<algebra::Vec3f> &contour,
@@ -230,11 +239,10 @@ void FlatPathGenerator::paintBorder(const std::vector<algebra::Vec3f> &contour,
   heightMap_->textureData_[4 * index] = 0;
   heightMap_->textureData_[4 * index + 1] = 255;
   heightMap_->textureData_[4 * index + 2] = 0;
-  heightMap_->texture_->fill(heightMap_->textureData_);
 }
 
 std::vector<std::list<FlatPathGenerator::Segment>>
-FlatPathGenerator::generateSegments() const {
+FlatPathGenerator::generateSegments(algebra::ProgressContext &progress) const {
   ///
   float line_distance = cutter_->diameter_ - kEpsilon;
 
@@ -276,6 +284,7 @@ FlatPathGenerator::generateSegments() const {
   //// process each line and check all possible cuts with contour
   auto line_count = static_cast<uint32_t>((max_z - min_z) / line_distance);
   for (uint32_t i = 0; i < line_count; ++i) {
+    progress.poll(static_cast<float>(i) / static_cast<float>(line_count));
     std::list<Segment> line_segments;
     auto curr_z = min_z + static_cast<float>(i) * line_distance;
 
@@ -491,13 +500,16 @@ std::vector<std::vector<algebra::Vec3f>> FlatPathGenerator::generatePaths(
   return paths;
 }
 
-void FlatPathGenerator::removeSelfIntersections() {
+void FlatPathGenerator::removeSelfIntersections(
+    algebra::ProgressContext &progress) {
 
   auto start_index = kInitialContourPoint;
   auto ind = start_index;
   auto contour_points = std::vector<algebra::Vec3f>();
   contour_points.push_back(contourPoints_[ind]);
   for (auto steps = 0u; steps < contourPoints_.size(); ++steps) {
+    progress.poll(static_cast<float>(steps) /
+                  static_cast<float>(contourPoints_.size()));
     auto next_ind = (ind + 1) % contourPoints_.size();
 
     auto p0 = algebra::Vec2f{contourPoints_[ind].x(), contourPoints_[ind].z()};
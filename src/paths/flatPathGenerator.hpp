@@ -4,6 +4,7 @@
 #include "cutter.hpp"
 #include "heightMap.hpp"
 #include "millingPath.hpp"
+#include "progress.hpp"
 #include "vec.hpp"
 #include <cstdint>
 #include <limits>
@@ -24,7 +25,9 @@ public:
     uint32_t endContourIndex_ = kMaxIndex;
   };
 
-  MillingPath generate();
+  /// the boundary scan, self intersection removal and line segmentation
+  /// poll per row, contour point or line
+  MillingPath generate(algebra::ProgressContext *progress = nullptr);
   void setCutter(const Cutter *cutter);
   void setHeightMap(HeightMap *heightMap);
 
@@ -34,13 +37,14 @@ private:
   std::unordered_map<uint32_t, algebra::Vec3f> boundaryNormalMap_;
   std::vector<algebra::Vec3f> contourPoints_;
 
-  std::vector<uint32_t> findBoundaryIndices();
+  std::vector<uint32_t> findBoundaryIndices(algebra::ProgressContext &progress);
   std::vector<algebra::Vec3f> findCutterPositionsFromBoundary(
       const std::vector<uint32_t> &boundaryIndices) const;
 
-  std::vector<std::list<FlatPathGenerator::Segment>> generateSegments() const;
+  std::vector<std::list<FlatPathGenerator::Segment>>
+  generateSegments(algebra::ProgressContext &progress) const;
 
-  void removeSelfIntersections();
+  void removeSelfIntersections(algebra::ProgressContext &progress);
 
   std::vector<std::vector<algebra::Vec3f>> generatePaths(
       std::vector<std::list<FlatPathGenerator::Segment>> &segments) const;
@@ -50,7 +54,8 @@ private:
   MillingPath combineLocalPaths(
       const std::vector<std::vector<algebra::Vec3f>> &localPaths) const;
 
-  /// helperFunction
+  /// helperFunction, paints texture data only, uploading it is up to the
+  /// height map owner
   void paintBorderRed(const std::vector<uint32_t> &boundaryIndices) const;
   void paintBorder(const std::vector<algebra::Vec3f> &contour,
                    Color color) const;
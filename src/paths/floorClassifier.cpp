@@ -0,0 +1,298 @@
+#include "floorClassifier.hpp"
+#include "intersectionTexture.hpp"
+#include "normalOffsetSurface.hpp"
+#include "surface.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+FloorClassifier::Stats
+FloorClassifier::classify(IntersectionTexture &texture) const {
+  Stats stats;
+  const auto size = texture.getSize();
+  const auto &patches = surface_.patches_;
+
+  std::vector<float> u_local(size.width);
+  std::vector<float> v_local(size.height);
+  const auto columns = patchRanges(size.width, patches.colCount, u_local);
+  const auto rows = patchRanges(size.height, patches.rowCount, v_local);
+
+  for (uint32_t row = 0; row < rows.size(); ++row) {
+    for (uint32_t col = 0; col < columns.size(); ++col) {
+      const Block block{.x = columns[col], .y = rows[row]};
+      if (block.x.begin >= block.x.end || block.y.begin >= block.y.end) {
+        continue;
+      }
+
+      /// any point inside the patch selects its control net
+      const auto center_uv =
+          algebra::Vec2f{(static_cast<float>(col) + 0.5f) /
+                             static_cast<float>(patches.colCount),
+                         (static_cast<float>(row) + 0.5f) /
+                             static_cast<float>(patches.rowCount)};
+      const auto local_patch = surface_.getCorrespondingBezierPatch(center_uv);
+
+      PatchContext patch{.nets = {}, .uLocal = &u_local, .vLocal = &v_local};
+      for (uint32_t c = 0; c < 3; ++c) {
+        for (uint32_t i = 0; i < 4; ++i) {
+          for (uint32_t j = 0; j < 4; ++j) {
+            patch.nets[c][i][j] = local_patch.patch[i][j][c];
+          }
+        }
+      }
+
+      classifyBlock(patch, block, texture, stats);
+    }
+  }
+
+  return stats;
+}
+
+void FloorClassifier::classifyBlock(const PatchContext &patch,
+                                    const Block &block,
+                                    IntersectionTexture &texture,
+                                    Stats &stats) const {
+  const auto &u_local = *patch.uLocal;
+  const auto &v_local = *patch.vLocal;
+
+  std::array<ControlNet, 3> nets;
+  for (uint32_t c = 0; c < 3; ++c) {
+    nets[c] = restrictNet(patch.nets[c], u_local[block.x.begin],
+                          u_local[block.x.end - 1], v_local[block.y.begin],
+                          v_local[block.y.end - 1]);
+  }
+
+  float min_height = nets[1][0][0];
+  float max_height = nets[1][0][0];
+  for (const auto &net_row : nets[1]) {
+    for (const auto height : net_row) {
+      min_height = std::min(min_height, height);
+      max_height = std::max(max_height, height);
+    }
+  }
+
+  const auto normal_y = normalYBounds(nets);
+  min_height += offset_ * normal_y.min;
+  max_height += offset_ * normal_y.max;
+
+  const float threshold = floorHeight_ + offset_;
+  if (max_height < threshold - kBoundEpsilon) {
+    trimBlock(block, texture);
+    stats.trimmedBlocks++;
+    return;
+  }
+  if (min_height >= threshold + kBoundEpsilon) {
+    stats.keptBlocks++;
+    return;
+  }
+
+  const auto width = block.x.end - block.x.begin;
+  const auto height = block.y.end - block.y.begin;
+  if (width <= kLeafSize && height <= kLeafSize) {
+    evaluateBlock(block, texture, stats);
+    return;
+  }
+
+  const auto x_mid = block.x.begin + width / 2;
+  const auto y_mid = block.y.begin + height / 2;
+
+  std::array<TexelRange, 2> x_halves{TexelRange{block.x.begin, x_mid},
+                                     TexelRange{x_mid, block.x.end}};
+  std::array<TexelRange, 2> y_halves{TexelRange{block.y.begin, y_mid},
+                                     TexelRange{y_mid, block.y.end}};
+  if (width <= kLeafSize) {
+    x_halves = {block.x, TexelRange{block.x.end, block.x.end}};
+  }
+  if (height <= kLeafSize) {
+    y_halves = {block.y, TexelRange{block.y.end, block.y.end}};
+  }
+
+  for (const auto &y_half : y_halves) {
+    for (const auto &x_half : x_halves) {
+      if (x_half.begin >= x_half.end || y_half.begin >= y_half.end) {
+        continue;
+      }
+      classifyBlock(patch, Block{.x = x_half, .y = y_half}, texture, stats);
+    }
+  }
+}
+
+void FloorClassifier::evaluateBlock(const Block &block,
+                                    IntersectionTexture &texture,
+                                    Stats &stats) const {
+  const auto offset_surface = algebra::NormalOffsetSurface(&surface_, offset_);
+
+  for (auto y = block.y.begin; y < block.y.end; ++y) {
+    for (auto x = block.x.begin; x < block.x.end; ++x) {
+      auto p = offset_surface.value(texture.uv(x, y));
+      stats.evaluations++;
+
+      if (p.y() < floorHeight_ + offset_) {
+        texture.setCellType(x, y, IntersectionTexture::CellType::Trim);
+      }
+    }
+  }
+}
+
+void FloorClassifier::trimBlock(const Block &block,
+                                IntersectionTexture &texture) const {
+  for (auto y = block.y.begin; y < block.y.end; ++y) {
+    for (auto x = block.x.begin; x < block.x.end; ++x) {
+      texture.setCellType(x, y, IntersectionTexture::CellType::Trim);
+    }
+  }
+}
+
+/// Splits texels between patches exactly the way
+/// BezierSurfaceC0::getCorrespondingBezierPatch does and stores local
+/// parameter of every texel.
+std::vector<FloorClassifier::TexelRange>
+FloorClassifier::patchRanges(uint32_t texels, uint32_t patchCount,
+                             std::vector<float> &local) {
+  std::vector<TexelRange> ranges(patchCount, TexelRange{texels, 0});
+
+  for (uint32_t texel = 0; texel < texels; ++texel) {
+    const float t = std::clamp(
+        static_cast<float>(texel) / static_cast<float>(texels), 0.f, 1.f);
+    const uint32_t patch =
+        std::min(static_cast<uint32_t>(t * patchCount), patchCount - 1);
+    const float patch_start =
+        static_cast<float>(patch) / static_cast<float>(patchCount);
+
+    local[texel] = std::clamp((t - patch_start) * patchCount, 0.f, 1.f);
+    ranges[patch].begin = std::min(ranges[patch].begin, texel);
+    ranges[patch].end = std::max(ranges[patch].end, texel + 1);
+  }
+
+  return ranges;
+}
+
+/// control points of the cubic restricted to [from, to] (de Casteljau)
+std::array<float, 4>
+FloorClassifier::restrictCubic(const std::array<float, 4> &b, float from,
+                               float to) {
+  auto lerp = [](float a, float b, float t) { return a + (b - a) * t; };
+
+  auto left_part = [&](const std::array<float, 4> &c, float t) {
+    const float c01 = lerp(c[0], c[1], t);
+    const float c12 = lerp(c[1], c[2], t);
+    const float c23 = lerp(c[2], c[3], t);
+    const float c012 = lerp(c01, c12, t);
+    const float c123 = lerp(c12, c23, t);
+    return std::array<float, 4>{c[0], c01, c012, lerp(c012, c123, t)};
+  };
+
+  auto right_part = [&](const std::array<float, 4> &c, float t) {
+    const float c01 = lerp(c[0], c[1], t);
+    const float c12 = lerp(c[1], c[2], t);
+    const float c23 = lerp(c[2], c[3], t);
+    const float c012 = lerp(c01, c12, t);
+    const float c123 = lerp(c12, c23, t);
+    return std::array<float, 4>{lerp(c012, c123, t), c123, c23, c[3]};
+  };
+
+  auto result = b;
+  if (to < 1.f) {
+    result = left_part(result, to);
+  }
+  if (from > 0.f && to > 0.f) {
+    result = right_part(result, from / to);
+  }
+  return result;
+}
+
+FloorClassifier::ControlNet
+FloorClassifier::restrictNet(const ControlNet &net, float uFrom, float uTo,
+                             float vFrom, float vTo) {
+  /// net[i][j], i runs along v and j along u
+  ControlNet result;
+  for (uint32_t i = 0; i < 4; ++i) {
+    result[i] = restrictCubic(net[i], uFrom, uTo);
+  }
+
+  for (uint32_t j = 0; j < 4; ++j) {
+    std::array<float, 4> column{result[0][j], result[1][j], result[2][j],
+                                result[3][j]};
+    column = restrictCubic(column, vFrom, vTo);
+    for (uint32_t i = 0; i < 4; ++i) {
+      result[i][j] = column[i];
+    }
+  }
+  return result;
+}
+
+/// Derivatives of a Bezier patch are convex combinations of control net
+/// differences, so their hulls bound every component of S_u and S_v. The
+/// normal's y component is (S_u x S_v)_y / |S_u x S_v|, where the length is
+/// bounded from below by the largest component that cannot vanish.
+FloorClassifier::Interval
+FloorClassifier::normalYBounds(const std::array<ControlNet, 3> &nets) {
+  std::array<Interval, 3> du;
+  std::array<Interval, 3> dv;
+
+  for (uint32_t c = 0; c < 3; ++c) {
+    const auto &net = nets[c];
+    du[c] = {.min = net[0][1] - net[0][0], .max = net[0][1] - net[0][0]};
+    dv[c] = {.min = net[1][0] - net[0][0], .max = net[1][0] - net[0][0]};
+
+    for (uint32_t i = 0; i < 4; ++i) {
+      for (uint32_t j = 0; j < 3; ++j) {
+        const float d = net[i][j + 1] - net[i][j];
+        du[c] = {.min = std::min(du[c].min, d), .max = std::max(du[c].max, d)};
+      }
+    }
+    for (uint32_t i = 0; i < 3; ++i) {
+      for (uint32_t j = 0; j < 4; ++j) {
+        const float d = net[i + 1][j] - net[i][j];
+        dv[c] = {.min = std::min(dv[c].min, d), .max = std::max(dv[c].max, d)};
+      }
+    }
+  }
+
+  auto mul = [](Interval a, Interval b) {
+    const std::array<float, 4> products{a.min * b.min, a.min * b.max,
+                                        a.max * b.min, a.max * b.max};
+    return Interval{.min = std::ranges::min(products),
+                    .max = std::ranges::max(products)};
+  };
+  auto sub = [](Interval a, Interval b) {
+    return Interval{.min = a.min - b.max, .max = a.max - b.min};
+  };
+  auto mignitude = [](Interval a) {
+    if (a.min <= 0.f && a.max >= 0.f) {
+      return 0.f;
+    }
+    return std::min(std::abs(a.min), std::abs(a.max));
+  };
+
+  const std::array<Interval, 3> cross{
+      sub(mul(du[1], dv[2]), mul(du[2], dv[1])),
+      sub(mul(du[2], dv[0]), mul(du[0], dv[2])),
+      sub(mul(du[0], dv[1]), mul(du[1], dv[0]))};
+
+  auto magnitude = [](Interval a) {
+    return std::max(std::abs(a.min), std::abs(a.max));
+  };
+
+  const float min_length = std::max(
+      {mignitude(cross[0]), mignitude(cross[1]), mignitude(cross[2])});
+  const float max_length = std::sqrt(
+      magnitude(cross[0]) * magnitude(cross[0]) +
+      magnitude(cross[1]) * magnitude(cross[1]) +
+      magnitude(cross[2]) * magnitude(cross[2]));
+
+  if (min_length <= 0.f) {
+    return {.min = -1.f, .max = 1.f};
+  }
+
+  /// a positive bound shrinks with the longest normal, a negative one with
+  /// the shortest
+  auto bound = [&](float value, bool lower) {
+    const float length = (value >= 0.f) == lower ? max_length : min_length;
+    return std::clamp(value / length, -1.f, 1.f);
+  };
+
+  return {.min = bound(cross[1].min, true), .max = bound(cross[1].max, false)};
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "intersectionTexture.hpp"
+#include "surface.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Marks intersection texture cells whose normal offset surface point lies
+/// below the floor as trimmed.
+///
+/// Instead of evaluating the offset surface in every texel, the height of
+/// each Bezier patch is bounded by its control net (convex hull property)
+/// and the offset by interval bounds of the normal's y component, taken from
+/// the hulls of the derivative nets. Texel blocks whose bound lies entirely
+/// above or below the floor are classified at once, only blocks straddling
+/// the floor are split further and, at leaf size, evaluated per texel.
+class FloorClassifier {
+public:
+  struct Stats {
+    std::size_t evaluations = 0;
+    std::size_t trimmedBlocks = 0;
+    std::size_t keptBlocks = 0;
+  };
+
+  FloorClassifier(const algebra::BezierSurfaceC0 &surface, float offset,
+                  float floorHeight)
+      : surface_(surface), offset_(offset), floorHeight_(floorHeight) {}
+
+  /// cells with offset height below floorHeight + offset become Trim,
+  /// other cells are left untouched
+  Stats classify(IntersectionTexture &texture) const;
+
+private:
+  using ControlNet = std::array<std::array<float, 4>, 4>;
+
+  struct Interval {
+    float min;
+    float max;
+  };
+
+  struct TexelRange {
+    uint32_t begin;
+    uint32_t end; // exclusive
+  };
+
+  struct Block {
+    TexelRange x;
+    TexelRange y;
+  };
+
+  struct PatchContext {
+    std::array<ControlNet, 3> nets; // x, y, z
+    const std::vector<float> *uLocal;
+    const std::vector<float> *vLocal;
+  };
+
+  static constexpr uint32_t kLeafSize = 4;
+  /// keeps float error of the subdivided hull from flipping a decision
+  static constexpr float kBoundEpsilon = 1e-4f;
+
+  const algebra::BezierSurfaceC0 &surface_;
+  float offset_;
+  float floorHeight_;
+
+  void classifyBlock(const PatchContext &patch, const Block &block,
+                     IntersectionTexture &texture, Stats &stats) const;
+  void evaluateBlock(const Block &block, IntersectionTexture &texture,
+                     Stats &stats) const;
+  void trimBlock(const Block &block, IntersectionTexture &texture) const;
+
+  static std::vector<TexelRange> patchRanges(uint32_t texels,
+                                             uint32_t patchCount,
+                                             std::vector<float> &local);
+  static std::array<float, 4> restrictCubic(const std::array<float, 4> &b,
+                                            float from, float to);
+  static ControlNet restrictNet(const ControlNet &net, float uFrom, float uTo,
+                                float vFrom, float vTo);
+  static Interval normalYBounds(const std::array<ControlNet, 3> &nets);
+};
@@ -143,6 +143,12 @@ uint32_t HeightMap::globalIndex(uint32_t x, uint32_t z) const {
 }
 
 void HeightMap::updateTexture() {
+  refreshTextureData();
+  uploadTexture();
+}
+
+void HeightMap::refreshTextureData() {
+  textureData_.resize(4 * data_.size());
 
   const auto max_height = 6.f;
 
@@ -153,7 +159,12 @@ void HeightMap::updateTexture() {
     textureData_[4 * i + 2] = channel_value;
     textureData_[4 * i + 3] = 255;
   }
+}
 
+void HeightMap::uploadTexture() {
+  if (!texture_) {
+    texture_ = Texture::createTexture(divisions_.x_, divisions_.z_);
+  }
   texture_->fill(textureData_);
 }
 
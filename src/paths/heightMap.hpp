@@ -5,6 +5,7 @@
 #include "texture.hpp"
 #include "vec.hpp"
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 struct Divisions {
@@ -24,6 +25,8 @@ public:
   float &at(uint32_t index) { return data_[index]; }
   float at(uint32_t index) const { return data_[index]; }
   const Block &block() const { return *block_; }
+  /// row major, x runs fastest
+  const std::vector<float> &heights() const { return data_; }
 
   algebra::Vec3f &normalAtIndex(uint32_t index);
   const algebra::Vec3f &normalAtIndex(uint32_t index) const;
@@ -31,7 +34,11 @@ public:
   float findMinimumSafeHeightForCut(
       uint32_t index, const Cutter &cutter) const; // this should be moved
 
-  uint32_t textureId() const { return texture_->getTextureId(); }
+  /// 0 until the first updateTexture, height maps built headless never
+  /// touch GL
+  uint32_t textureId() const {
+    return texture_ ? texture_->getTextureId() : 0;
+  }
 
   void saveToFile() const;
 
@@ -40,18 +47,17 @@ public:
   friend class RoughingPathGenerator;
   friend class FlatPathGenerator;
   friend class DetailedPathGenerator;
+  friend class MillingSimulator;
 
 private:
   Divisions divisions_;
   float baseHeight_;
   const Block *block_;
-  std::unique_ptr<Texture> texture_ =
-      Texture::createTexture(divisions_.x_, divisions_.z_);
+  std::unique_ptr<Texture> texture_ = nullptr;
 
   std::vector<float> data_ =
       std::vector<float>(divisions_.x_ * divisions_.z_, baseHeight_);
-  std::vector<uint8_t> textureData_ =
-      std::vector<uint8_t>(4 * divisions_.x_ * divisions_.z_, 0);
+  std::vector<uint8_t> textureData_;
 
   std::vector<algebra::Vec3f> normalData_ =
       std::vector<algebra::Vec3f>(divisions_.x_ * divisions_.z_);
@@ -65,4 +71,8 @@ private:
   float findMinimumSafeHeightForCut(algebra::Vec3f point,
                                     const Cutter &cutter) const;
   void updateTexture();
+  /// grey scale of the heights, CPU only so workers may call it
+  void refreshTextureData();
+  /// GL, main thread only
+  void uploadTexture();
 };
\ No newline at end of file
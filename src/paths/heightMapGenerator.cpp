@@ -11,13 +11,19 @@ static constexpr float kBaseHeight = 1.5f;
 static constexpr uint32_t kDivisions = 4000;
 static constexpr uint32_t kBaseDivisions = 1500;
 
-HeightMap HeightMapGenerator::generateHeightMap(const Model &model,
-                                                const Block &block) {
+HeightMap
+HeightMapGenerator::generateHeightMap(const Model &model, const Block &block,
+                                      algebra::ProgressContext *progress) {
   HeightMap height_map(Divisions{.x_ = kBaseDivisions, .z_ = kBaseDivisions},
                        kBaseHeight, &block);
 
-  for (const auto *surface : model.surfaces()) {
-    processSurface(*surface, height_map);
+  algebra::ProgressContext untracked;
+  auto &root = progress != nullptr ? *progress : untracked;
+  const auto &surfaces = model.surfaces();
+  for (const auto *surface : surfaces) {
+    algebra::ProgressContext surface_progress(
+        root, 1.f / static_cast<float>(surfaces.size()));
+    processSurface(*surface, height_map, surface_progress);
   }
 
   height_map.saveToFile();
@@ -26,13 +32,16 @@ HeightMap HeightMapGenerator::generateHeightMap(const Model &model,
   return height_map;
 }
 
-void HeightMapGenerator::processSurface(const BezierSurface &surface,
-                                        HeightMap &heightMap) const {
+void HeightMapGenerator::processSurface(
+    const BezierSurface &surface, HeightMap &heightMap,
+    algebra::ProgressContext &progress) const {
 
   const uint32_t u_divisions = kDivisions;
   const uint32_t v_divisions = kDivisions;
 
   for (uint32_t u_index = 0; u_index < u_divisions; ++u_index) {
+    progress.poll(static_cast<float>(u_index) /
+                  static_cast<float>(u_divisions));
     for (uint32_t v_index = 0; v_index < v_divisions; ++v_index) {
       float u = static_cast<float>(u_index) / static_cast<float>(u_divisions);
       float v = static_cast<float>(v_index) / static_cast<float>(v_divisions);
@@ -4,13 +4,18 @@
 #include "block.hpp"
 #include "heightMap.hpp"
 #include "model.hpp"
+#include "progress.hpp"
 
 class HeightMapGenerator {
 public:
-  HeightMap generateHeightMap(const Model &model, const Block &block);
+  /// every surface gets an equal share of progress
+  HeightMap generateHeightMap(const Model &model, const Block &block,
+                              algebra::ProgressContext *progress = nullptr);
 
 private:
-  void processSurface(const BezierSurface &surface, HeightMap &heightMap) const;
+  /// polls once per row of samples
+  void processSurface(const BezierSurface &surface, HeightMap &heightMap,
+                      algebra::ProgressContext &progress) const;
   void generateFromFiles(const std::string &height_file,
                          const std::string &normal_file,
                          HeightMap &heightMap) const;
@@ -4,10 +4,14 @@
 #include "millingPath.hpp"
 #include "namedPath.hpp"
 #include "pathReader.hpp"
+#include "rdp.hpp"
 #include "vec.hpp"
 #include <cstdint>
 #include <memory>
 
+/// max deviation [cm] of the reduced path from the original one
+static constexpr float kReduceEpsilon = 0.001f;
+
 void PathCombiner::addPaths(
     std::vector<std::filesystem::path> &millingPathFiles) {
   auto paths = MillingPathReader::readPaths(millingPathFiles);
@@ -72,61 +76,16 @@ void PathCombiner::reducePath(uint32_t index) {
   }
 
   auto &path = millingPaths_[index];
-  // Get reference to the vector so we can update it later
-  auto &original_points = path->points();
+  const auto &original_points = path->points();
 
   // If path is too small to reduce, do nothing
   if (original_points.size() < 3) {
     return;
   }
 
-  std::vector<algebra::Vec3f> new_points;
-  // Pre-allocate to prevent multiple reallocations
-  new_points.reserve(original_points.size());
-
-  // 1. Always keep the FIRST point
-  new_points.push_back(original_points.front());
-
-  // Define the threshold squared (0.1 * 0.1) to avoid expensive sqrt() calls
-  const float min_dist_sq = 0.05f * 0.05f;
-
-  // 2. Iterate through the middle points
-  // We check distance against the 'new_points.back()' (the last VALID point
-  // we added) rather than 'original_points[i-1]'. This filters out clusters
-  // of tiny points.
-  for (size_t i = 1; i < original_points.size() - 1; ++i) {
-    const auto &current_point = original_points[i];
-    const auto &last_accepted = new_points.back();
-
-    // Calculate Squared Euclidean Distance
-    algebra::Vec3f diff = current_point - last_accepted;
-    float dist_sq = diff.dot(diff);
-
-    // If the distance is significant enough, keep the point.
-    // Otherwise, we skip it (it is effectively merged into the previous
-    // line).
-    if (dist_sq >= min_dist_sq) {
-      new_points.push_back(current_point);
-    }
-  }
-
-  // 3. Always keep the LAST point to preserve the end of the cut
-  // Check to ensure we don't duplicate if the simplified path ended up very
-  // close to the end
-  const auto &last_original = original_points.back();
-  const auto &last_new = new_points.back();
-
-  float final_dist_sq =
-      (last_original - last_new).dot(last_original - last_new);
-
-  // Only add the last point if it's different from the current end,
-  // OR if the result would be just 1 point (we need at least 2 for a line)
-  if (final_dist_sq > 0.000001f || new_points.size() < 2) {
-    new_points.push_back(last_original);
-  }
+  auto new_points =
+      algebra::RDP::reducePoints(original_points, kReduceEpsilon);
 
-  // 4. Update the path with the reduced list
-  // Assuming 'points()' returns a non-const reference we can assign to
   std::string new_name = path->name() + "_reduced";
   millingPaths_.emplace_back(std::make_unique<NamedPath>(new_points, new_name));
 }
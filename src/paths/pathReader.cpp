@@ -1,10 +1,15 @@
 #include "pathReader.hpp"
+#include "arcFitter.hpp"
 #include "namedPath.hpp"
+#include "plane.hpp"
+#include "toolMove.hpp"
 #include "vec.hpp"
 #include <algorithm>
+#include <cctype>
 #include <filesystem>
 #include <fstream>
 #include <memory>
+#include <optional>
 #include <ranges>
 #include <stdexcept>
 #include <utility>
@@ -27,6 +32,12 @@ std::vector<std::unique_ptr<NamedPath>> MillingPathReader::readPaths(
 
 std::unique_ptr<NamedPath>
 MillingPathReader::readPath(const std::filesystem::path &millingPathFile) {
+  return std::make_unique<NamedPath>(readPoints(millingPathFile),
+                                     millingPathFile.filename());
+}
+
+std::vector<algebra::Vec3f>
+MillingPathReader::readPoints(const std::filesystem::path &millingPathFile) {
   std::vector<algebra::Vec3f> points;
 
   std::ifstream file(millingPathFile);
@@ -34,9 +45,28 @@ MillingPathReader::readPath(const std::filesystem::path &millingPathFile) {
     throw std::runtime_error("Cannot open file: " + millingPathFile.string());
   }
 
+  /// G17 is the machine default
+  auto plane = algebra::Plane::XZ;
+
   for (const auto &line : std::views::istream<std::string>(file)) {
     try {
+      if (line.contains("G17")) {
+        plane = algebra::Plane::XZ;
+      } else if (line.contains("G18")) {
+        plane = algebra::Plane::XY;
+      }
+
       algebra::Vec3f point = readLine(line);
+
+      const bool clockwise = line.contains("G02");
+      if (!points.empty() && (clockwise || line.contains("G03"))) {
+        const auto arc = readArc(line, points.back(), point, plane, clockwise);
+        auto arc_points =
+            ArcFitter::tessellate(points.back(), arc, kArcStepAngle);
+        points.insert(points.end(), arc_points.begin(), arc_points.end());
+        continue;
+      }
+
       points.push_back(point);
     } catch (const std::exception &e) {
       throw std::runtime_error("Warning: Skipping invalid line " + line + " " +
@@ -44,9 +74,34 @@ MillingPathReader::readPath(const std::filesystem::path &millingPathFile) {
     }
   }
 
-  return std::make_unique<NamedPath>(std::move(points),
-                                     millingPathFile.filename());
+  return points;
+}
+
+/// extension names the cutter: k - ball, f - flat, followed by diameter [mm]
+Cutter
+MillingPathReader::readCutter(const std::filesystem::path &millingPathFile) {
+  const auto extension = millingPathFile.extension().string();
+  if (extension.size() < 3 || (extension[1] != 'k' && extension[1] != 'f')) {
+    throw std::runtime_error("Unknown cutter for file: " +
+                             millingPathFile.string());
+  }
+
+  int diameter_mm = 0;
+  for (const char digit : extension.substr(2)) {
+    if (!std::isdigit(digit)) {
+      throw std::runtime_error("Unknown cutter for file: " +
+                               millingPathFile.string());
+    }
+    diameter_mm = diameter_mm * 10 + (digit - '0');
+  }
+
+  const auto type =
+      extension[1] == 'k' ? Cutter::Type::Ball : Cutter::Type::Flat;
+  return Cutter{.type_ = type,
+                .diameter_ = static_cast<float>(diameter_mm) / 10.f,
+                .height_ = kCuttingLength};
 }
+
 algebra::Vec3f MillingPathReader::readLine(const std::string &line) {
   size_t x_pos = line.find('X');
   size_t y_pos = line.find('Y');
@@ -67,6 +122,50 @@ algebra::Vec3f MillingPathReader::readLine(const std::string &line) {
 
   return algebra::Vec3f(x, z, y);
 }
+
+/// Center words are machine offsets from the arc start: I->x, J->world z
+/// (G17), K->world y (G18). See GCodeSerializer::serializeMoves for the
+/// direction convention.
+ToolMove MillingPathReader::readArc(const std::string &line,
+                                    const algebra::Vec3f &start,
+                                    const algebra::Vec3f &end,
+                                    algebra::Plane plane, bool clockwise) {
+  const bool g17 = plane == algebra::Plane::XZ;
+  const auto i = readWord(line, 'I');
+  const auto second = readWord(line, g17 ? 'J' : 'K');
+  if (!i || !second) {
+    throw std::invalid_argument("Arc missing center offset");
+  }
+
+  auto center = start;
+  center.x() += *i;
+  if (g17) {
+    center.z() += *second;
+  } else {
+    center.y() += *second;
+  }
+
+  return ToolMove{.type_ = ToolMove::Type::Arc,
+                  .end_ = end,
+                  .center_ = center,
+                  .plane_ = plane,
+                  .counterClockwise_ = g17 ? !clockwise : clockwise};
+}
+
+std::optional<float> MillingPathReader::readWord(const std::string &line,
+                                                 char letter) {
+  const size_t pos = line.find(letter);
+  if (pos == std::string::npos) {
+    return std::nullopt;
+  }
+
+  size_t end = pos + 1;
+  while (end < line.size() && !std::isalpha(line[end])) {
+    ++end;
+  }
+  return parseCoordinate(line.substr(pos + 1, end - pos - 1));
+}
+
 float MillingPathReader::parseCoordinate(const std::string &coordinate) {
 
   float sign = coordinate[0] == '-' ? -1.f : 1.f;
@@ -1,9 +1,14 @@
 #pragma once
 
+#include "cutter.hpp"
 #include "namedPath.hpp"
+#include "plane.hpp"
+#include "toolMove.hpp"
 #include "vec.hpp"
 #include <filesystem>
 #include <memory>
+#include <optional>
+#include <string>
 #include <vector>
 
 class MillingPathReader {
@@ -14,7 +19,23 @@ public:
   static std::unique_ptr<NamedPath>
   readPath(const std::filesystem::path &millingPathFile);
 
+  /// tool tip positions in world coordinates, creates no GL resources
+  static std::vector<algebra::Vec3f>
+  readPoints(const std::filesystem::path &millingPathFile);
+
+  /// cutter named by the file extension (.k16, .f10, .k08)
+  static Cutter readCutter(const std::filesystem::path &millingPathFile);
+
 private:
+  /// flute length [cm] assumed for cutters read from file names
+  static constexpr float kCuttingLength = 4.f;
+  /// G02/G03 are read back as polylines with this angular step [rad]
+  static constexpr float kArcStepAngle = 0.05f;
+
   static algebra::Vec3f readLine(const std::string &line);
+  static ToolMove readArc(const std::string &line, const algebra::Vec3f &start,
+                          const algebra::Vec3f &end, algebra::Plane plane,
+                          bool clockwise);
+  static std::optional<float> readWord(const std::string &line, char letter);
   static float parseCoordinate(const std::string &coordinate);
 };
\ No newline at end of file
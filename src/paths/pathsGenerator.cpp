@@ -1,13 +1,42 @@
 #include "pathsGenerator.hpp"
+#include "finishAnalysis.hpp"
 #include "heightMap.hpp"
 #include "intersectionFinder.hpp"
 #include "model.hpp"
+#include "pathReader.hpp"
+#include "scene.hpp"
+#include "stockSimulation.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
 #include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+PathsGenerator::PathsGenerator() {
+  detailedPathGenerator_.setDialect(&dialect_);
+  buildPipeline();
+}
 
 void PathsGenerator::setModel(const std::vector<BezierSurface *> &surfaces) {
   model_ = std::make_unique<Model>(surfaces);
 }
 
+void PathsGenerator::forgetRemoved(const Scene &scene) {
+  const auto removed = [&scene](const IEntity *entity) {
+    return !scene.contains(entity);
+  };
+  if (model_ && std::ranges::any_of(model_->surfaces(), removed)) {
+    model_ = nullptr;
+  }
+  std::erase_if(intersectionCurves_, removed);
+}
+
 void PathsGenerator::setIntersectionFinder(
     IntersectionFinder *intersectionFinder) {
   detailedPathGenerator_.setIntersectionFinder(intersectionFinder);
@@ -16,42 +45,217 @@ void PathsGenerator::setScene(Scene *scene) {
   detailedPathGenerator_.setScene(scene);
 }
 
-void PathsGenerator::run() {
+void PathsGenerator::run(algebra::ProgressContext *progress) {
+  runPipeline({"roughing", "flat"}, progress);
+}
 
-  heightMap_ = std::make_unique<HeightMap>(
-      heightMapGenerator_.generateHeightMap(*model_, block_));
-  heightMap_->updateTexture();
+void PathsGenerator::generateDetailed(algebra::ProgressContext *progress) {
+  runPipeline({"detailed"}, progress);
+}
 
-  // ------ Roughing Path ---------------------------
-  Cutter roughing_cutter{
-      .type_ = Cutter::Type::Ball,
-      .diameter_ = 1.6f,
-      .height_ = 2.f * 1.6f,
-  };
-  roughingPathGenerator_.setHeightMap(heightMap_.get());
-  roughingPathGenerator_.setCutter(&roughing_cutter);
-  auto roughing_path = roughingPathGenerator_.generate();
-  GCodeSerializer::serializePath(roughing_path, "1.k16");
-
-  // ------ Flat Path ---------------------------
-  Cutter flat_cutter{
-      .type_ = Cutter::Type::Flat,
-      .diameter_ = 1.0f,
-      .height_ = 1.0f,
-  };
+void PathsGenerator::generateIntersectionPaths(
+    const std::vector<const IntersectionCurve *> &curves,
+    algebra::ProgressContext *progress) {
+  intersectionCurves_ = curves;
+  runPipeline({"intersections"}, progress);
+}
+
+void PathsGenerator::uploadTextures() {
+  if (heightMap_) {
+    heightMap_->uploadTexture();
+  }
+  detailedPathGenerator_.uploadTextures();
+}
+
+void PathsGenerator::buildPipeline() {
+  pipeline_.addStage({
+      .name_ = "heightMap",
+      .inputs_ = {},
+      .key_ = [this] { return modelKey(); },
+      .run_ =
+          [this](algebra::ProgressContext &progress) {
+            heightMap_ = std::make_shared<HeightMap>(
+                heightMapGenerator_.generateHeightMap(*model_, block_,
+                                                      &progress));
+            heightMap_->refreshTextureData();
+          },
+  });
+
+  pipeline_.addStage({
+      .name_ = "roughing",
+      .inputs_ = {"heightMap"},
+      .key_ =
+          [this] { return toolKey(roughing_.cutter_, roughing_.fileStem_); },
+      .run_ =
+          [this](algebra::ProgressContext &progress) {
+            roughingPathGenerator_.setHeightMap(heightMap_.get());
+            roughingPathGenerator_.setCutter(&roughing_.cutter_);
+            GCodeSerializer::serializePath(
+                roughingPathGenerator_.generate(&progress),
+                roughing_.fileName(), dialect_);
+          },
+  });
+
+  /// paints the contour into the height map texture data, roughing and
+  /// detailed paths only read heights
+  pipeline_.addStage({
+      .name_ = "flat",
+      .inputs_ = {"heightMap"},
+      .key_ = [this] { return toolKey(flat_.cutter_, flat_.fileStem_); },
+      .run_ =
+          [this](algebra::ProgressContext &progress) {
+            heightMap_->refreshTextureData();
+            flatPathGenerator_.setHeightMap(heightMap_.get());
+            flatPathGenerator_.setCutter(&flat_.cutter_);
+            GCodeSerializer::serializePath(
+                flatPathGenerator_.generate(&progress), flat_.fileName(),
+                dialect_);
+          },
+  });
+
+  pipeline_.addStage({
+      .name_ = "detailed",
+      .inputs_ = {"heightMap"},
+      .key_ =
+          [this] {
+            ContentHash hash;
+            hash.add(toolKey(detailedCutter_, ""))
+                .add(detailedPathGenerator_.lines())
+                .add(detailedPathGenerator_.direction())
+                .add(detailedPathGenerator_.chordTolerance());
+            /// trimming edits the textures, paths follow the trimmed cells
+            for (auto *surface : model_->surfaces()) {
+              const auto *texture = surface->getIntersectionTexture();
+              hash.add(texture != nullptr);
+              if (texture != nullptr) {
+                hash.add(texture->id()).add(texture->revision());
+              }
+            }
+            return hash.value();
+          },
+      .run_ =
+          [this](algebra::ProgressContext &progress) {
+            detailedPathGenerator_.setModel(model_.get());
+            detailedPathGenerator_.setHeightMap(heightMap_.get());
+            detailedPathGenerator_.generate(&progress);
+          },
+      /// floor classification trims the textures it hashes
+      .keyAfterRun_ = true,
+  });
+
+  pipeline_.addStage({
+      .name_ = "intersections",
+      .inputs_ = {},
+      .key_ =
+          [this] {
+            ContentHash hash;
+            hash.add(toolKey(detailedCutter_, ""));
+            for (const auto *curve : intersectionCurves_) {
+              hash.add(curve->getName());
+              for (const auto &point : curve->getPolyline().getPoints()) {
+                hash.add(point.x()).add(point.y()).add(point.z());
+              }
+            }
+            return hash.value();
+          },
+      .run_ =
+          [this](algebra::ProgressContext &progress) {
+            for (const auto &[i, curve] :
+                 intersectionCurves_ | std::views::enumerate) {
+              progress.poll(static_cast<float>(i) /
+                            static_cast<float>(intersectionCurves_.size()));
+              detailedPathGenerator_.generatePathForIntersectionCurve(*curve);
+            }
+          },
+  });
+}
 
-  flatPathGenerator_.setCutter(&flat_cutter);
-  flatPathGenerator_.setHeightMap(heightMap_.get());
-  auto flat_path = flatPathGenerator_.generate();
-  GCodeSerializer::serializePath(flat_path, "2.f10");
-  // ------ Detailed Path ---------------------
-  Cutter detailed_cutter{
-      .type_ = Cutter::Type::Ball,
-      .diameter_ = 0.8f,
-      .height_ = 0.8f,
+void PathsGenerator::runPipeline(const std::vector<std::string> &targets,
+                                 algebra::ProgressContext *progress) {
+  if (!model_) {
+    throw std::runtime_error("No model set for path generation");
+  }
+
+  /// shared by the detailed and intersection stages, set before any of them
+  /// starts
+  detailedPathGenerator_.setCutter(detailedCutter_);
+  pipeline_.run(targets, progress);
+}
+
+uint64_t PathsGenerator::modelKey() const {
+  ContentHash hash;
+  hash.add(block_.dimensions_.x_)
+      .add(block_.dimensions_.y_)
+      .add(block_.dimensions_.z_);
+  for (const auto *surface : model_->surfaces()) {
+    for (const auto &point : surface->getPointsReferences()) {
+      const auto &position = point.get().getPosition();
+      hash.add(position.x()).add(position.y()).add(position.z());
+    }
+  }
+  return hash.value();
+}
+
+uint64_t PathsGenerator::toolKey(const Cutter &cutter,
+                                 const std::string &fileStem) const {
+  ContentHash hash;
+  hash.add(cutter.type_)
+      .add(cutter.diameter_)
+      .add(cutter.height_)
+      .add(fileStem)
+      .add(dialect_.arcs_)
+      .add(dialect_.arcTolerance_);
+  return hash.value();
+}
+
+void PathsGenerator::simulate(
+    std::vector<std::filesystem::path> millingPathFiles) {
+  std::ranges::sort(millingPathFiles);
+
+  std::vector<StockSimulation::Job> jobs;
+  jobs.reserve(millingPathFiles.size());
+  for (const auto &file : millingPathFiles) {
+    jobs.push_back(StockSimulation::Job{
+        .name_ = file.filename().string(),
+        .points_ = MillingPathReader::readPoints(file),
+        .cutter_ = MillingPathReader::readCutter(file),
+    });
+  }
+
+  const auto divisions = heightMap_ ? heightMap_->divisions() : Divisions{};
+  simulation_ = std::make_unique<StockSimulation>(
+      divisions, &block_, heightMap_, std::move(jobs));
+}
+
+void PathsGenerator::analyzeFinish() {
+  if (!simulation_ || !heightMap_) {
+    return;
+  }
+
+  FinishAnalysis analysis(simulation_->stock(), *heightMap_);
+  const auto summary = analysis.analyze();
+
+  auto report = FinishAnalysis::toJson(summary);
+  for (const auto &job : simulation_->jobs()) {
+    report["paths"].push_back(job.name_);
+  }
+  report["parameters"] = {
+      {"detailedLines", detailedPathGenerator_.lines()},
+      {"chordTolerance", detailedPathGenerator_.chordTolerance()},
   };
-  detailedPathGenerator_.setModel(model_.get());
-  detailedPathGenerator_.setCutter(detailed_cutter);
-  detailedPathGenerator_.setHeightMap(heightMap_.get());
-  // detailedPathGenerator_.generate();
-}
\ No newline at end of file
+
+  std::ofstream out("finish_report.json");
+  if (!out) {
+    throw std::runtime_error("Failed to open file: finish_report.json");
+  }
+  out << std::setw(4) << report << std::endl;
+
+  analysis.saveImage("finish.ppm");
+
+  const auto &divisions = heightMap_->divisions();
+  if (!finishTexture_) {
+    finishTexture_ = Texture::createTexture(divisions.x_, divisions.z_);
+  }
+  finishTexture_->fill(analysis.falseColour());
+  finishSummary_ = summary;
+}
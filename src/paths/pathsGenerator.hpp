@@ -3,33 +3,104 @@
 #include "bezierSurface.hpp"
 #include "block.hpp"
 #include "detailedPathGenerator.hpp"
+#include "finishAnalysis.hpp"
 #include "flatPathGenerator.hpp"
 #include "heightMap.hpp"
 #include "heightMapGenerator.hpp"
 #include "intersectionFinder.hpp"
 #include "model.hpp"
+#include "pipeline.hpp"
+#include "progress.hpp"
 #include "roughingPathGenerator.hpp"
+#include "texture.hpp"
+#include "stockSimulation.hpp"
+#include <filesystem>
 #include <memory>
+#include <optional>
+#include <string>
 #include <vector>
 
 class PathsGenerator {
 public:
-  void run();
+  /// output file is fileStem_ with the cutter's extension, e.g. 1.k16
+  struct Tool {
+    Cutter cutter_;
+    std::string fileStem_;
+
+    std::string fileName() const {
+      return fileStem_ + "." + cutter_.fileExtension();
+    }
+  };
+
+  PathsGenerator();
+
+  /// height map, roughing and flat paths, unchanged stages are skipped.
+  /// Generation does not touch GL and may run on a worker thread,
+  /// uploadTextures() publishes the results afterwards.
+  void run(algebra::ProgressContext *progress = nullptr);
+  /// detailed surface paths, regenerates the height map only when stale
+  void generateDetailed(algebra::ProgressContext *progress = nullptr);
+  void generateIntersectionPaths(
+      const std::vector<const IntersectionCurve *> &curves,
+      algebra::ProgressContext *progress = nullptr);
+  /// height map and trimmed intersection textures, main thread only
+  void uploadTextures();
+  /// intersection textures are edited outside the pipeline, this forces
+  /// every stage to run again
+  void invalidate() { pipeline_.invalidate(); }
+  /// starts playing G-code files back in order on fresh stock, gouges are
+  /// checked against the model height map when one was generated
+  void simulate(std::vector<std::filesystem::path> millingPathFiles);
   void setIntersectionFinder(IntersectionFinder *intersectionFinder);
   void setModel(const std::vector<BezierSurface *> &surfaces);
+  /// Drops the model when any of its surfaces left the scene, and the
+  /// intersection curves that did. Main thread only, with no task running.
+  void forgetRemoved(const Scene &scene);
   void setScene(Scene *scene);
   DetailedPathGenerator &getDetailedPathGenerator() {
     return detailedPathGenerator_;
   }
 
   const HeightMap *heightMap() const { return heightMap_.get(); }
+  StockSimulation *simulation() { return simulation_.get(); }
+
+  /// compares simulated stock with the model height map, writes
+  /// finish_report.json and finish.ppm to the working directory
+  void analyzeFinish();
+  const Texture *finishTexture() const { return finishTexture_.get(); }
+  /// of the last analyzeFinish(), empty before the first one
+  const std::optional<FinishAnalysis::Summary> &finishSummary() const {
+    return finishSummary_;
+  }
+  GCodeDialect &dialect() { return dialect_; }
+  Tool &roughingTool() { return roughing_; }
+  Tool &flatTool() { return flat_; }
+  Cutter &detailedCutter() { return detailedCutter_; }
 
 private:
   std::unique_ptr<Model> model_ = nullptr;
   HeightMapGenerator heightMapGenerator_;
   Block block_ = Block::defaultBlock();
 
-  std::unique_ptr<HeightMap> heightMap_ = nullptr;
+  /// shared with the simulation so regenerating it does not pull the
+  /// design out from under a running playback
+  std::shared_ptr<HeightMap> heightMap_ = nullptr;
+  GCodeDialect dialect_;
+  std::unique_ptr<StockSimulation> simulation_ = nullptr;
+  std::unique_ptr<Texture> finishTexture_ = nullptr;
+  std::optional<FinishAnalysis::Summary> finishSummary_;
+
+  Tool roughing_{
+      .cutter_{.type_ = Cutter::Type::Ball, .diameter_ = 1.6f, .height_ = 3.2f},
+      .fileStem_ = "1"};
+  Tool flat_{
+      .cutter_{.type_ = Cutter::Type::Flat, .diameter_ = 1.0f, .height_ = 1.f},
+      .fileStem_ = "2"};
+  Cutter detailedCutter_{
+      .type_ = Cutter::Type::Ball, .diameter_ = 0.8f, .height_ = 0.8f};
+  std::vector<const IntersectionCurve *> intersectionCurves_;
+
+  Pipeline pipeline_;
 
   /// Generators
   RoughingPathGenerator roughingPathGenerator_;
@@ -37,4 +108,9 @@ private:
   DetailedPathGenerator detailedPathGenerator_;
 
   /// Helpers
+  void buildPipeline();
+  void runPipeline(const std::vector<std::string> &targets,
+                   algebra::ProgressContext *progress);
+  uint64_t modelKey() const;
+  uint64_t toolKey(const Cutter &cutter, const std::string &fileStem) const;
 };
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include "pipeline.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+void Pipeline::addStage(Stage stage) {
+  if (indices_.contains(stage.name_)) {
+    throw std::runtime_error("Duplicate pipeline stage: " + stage.name_);
+  }
+  for (const auto &input : stage.inputs_) {
+    indexOf(input);
+  }
+
+  indices_.emplace(stage.name_, stages_.size());
+  stages_.push_back(std::move(stage));
+}
+
+void Pipeline::run(const std::vector<std::string> &targets,
+                   algebra::ProgressContext *progress) {
+  PROFILE_SCOPE("Pipeline::run");
+  std::vector<bool> needed(stages_.size(), false);
+  for (const auto &target : targets) {
+    needed[indexOf(target)] = true;
+  }
+  /// inputs always precede their consumers
+  for (auto i = stages_.size(); i-- > 0;) {
+    if (needed[i]) {
+      for (const auto &input : stages_[i].inputs_) {
+        needed[indexOf(input)] = true;
+      }
+    }
+  }
+
+  std::vector<uint64_t> keys(stages_.size(), 0);
+  auto key_of = [&](std::size_t i) {
+    ContentHash hash;
+    hash.add(stages_[i].key_());
+    for (const auto &input : stages_[i].inputs_) {
+      hash.add(keys[indexOf(input)]);
+    }
+    return hash.value();
+  };
+  for (std::size_t i = 0; i < stages_.size(); ++i) {
+    if (needed[i]) {
+      keys[i] = key_of(i);
+    }
+  }
+
+  algebra::ProgressContext untracked;
+  auto &root = progress != nullptr ? *progress : untracked;
+  const auto share =
+      1.f / static_cast<float>(std::max<std::ptrdiff_t>(
+                1, std::ranges::count(needed, true)));
+  std::vector<std::unique_ptr<algebra::ProgressContext>> stage_progress(
+      stages_.size());
+  for (std::size_t i = 0; i < stages_.size(); ++i) {
+    if (needed[i]) {
+      stage_progress[i] =
+          std::make_unique<algebra::ProgressContext>(root, share);
+    }
+  }
+
+  auto dirty = [&](std::size_t i) {
+    const auto cached = keys_.find(stages_[i].name_);
+    return cached == keys_.end() || cached->second != keys[i];
+  };
+
+  auto inputs_of = [&](std::size_t i, const auto &done) {
+    std::vector<std::shared_future<void>> inputs;
+    for (const auto &input : stages_[i].inputs_) {
+      inputs.push_back(done[indexOf(input)]);
+    }
+    return inputs;
+  };
+
+  std::vector<std::shared_future<void>> done(stages_.size());
+  for (std::size_t i = 0; i < stages_.size(); ++i) {
+    if (!needed[i]) {
+      continue;
+    }
+    done[i] = std::async(std::launch::async,
+                         [&stage = stages_[i], inputs = inputs_of(i, done),
+                          is_dirty = dirty(i),
+                          &progress = *stage_progress[i]] {
+                           for (const auto &input : inputs) {
+                             input.get();
+                           }
+                           execute(stage, is_dirty, progress);
+                         })
+                  .share();
+  }
+
+  std::exception_ptr error = nullptr;
+  for (std::size_t i = 0; i < stages_.size(); ++i) {
+    if (!needed[i]) {
+      continue;
+    }
+    try {
+      done[i].get();
+      if (stages_[i].keyAfterRun_) {
+        keys[i] = key_of(i);
+      }
+      keys_[stages_[i].name_] = keys[i];
+    } catch (...) {
+      keys_.erase(stages_[i].name_);
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+std::size_t Pipeline::indexOf(const std::string &name) const {
+  const auto index = indices_.find(name);
+  if (index == indices_.end()) {
+    throw std::runtime_error("Unknown pipeline stage: " + name);
+  }
+  return index->second;
+}
+
+void Pipeline::execute(const Stage &stage, bool dirty,
+                       algebra::ProgressContext &progress) {
+  if (!dirty) {
+    progress.report(1.f);
+    return;
+  }
+
+  progress.throwIfCancelled();
+
+  PROFILE_SCOPE(stage.name_.c_str());
+  stage.run_(progress);
+  progress.report(1.f);
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "progress.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/// FNV-1a over raw bytes, stable between runs so keys of different runs can
+/// be compared. Add fields one by one, padding of whole structs is not
+/// deterministic.
+class ContentHash {
+public:
+  template <typename T>
+    requires std::is_trivially_copyable_v<T>
+  ContentHash &add(const T &value) {
+    return addBytes(&value, sizeof(T));
+  }
+
+  ContentHash &add(std::string_view text) {
+    add(text.size());
+    return addBytes(text.data(), text.size());
+  }
+
+  uint64_t value() const { return value_; }
+
+private:
+  static constexpr uint64_t kOffsetBasis = 14695981039346656037ull;
+  static constexpr uint64_t kPrime = 1099511628211ull;
+
+  uint64_t value_ = kOffsetBasis;
+
+  ContentHash &addBytes(const void *data, std::size_t size) {
+    const auto *bytes = static_cast<const unsigned char *>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+      value_ = (value_ ^ bytes[i]) * kPrime;
+    }
+    return *this;
+  }
+};
+
+/// Stages declare the stages whose output they read. A stage's key is the
+/// hash of its own parameters combined with the keys of its inputs, so a
+/// stage re-runs only when something it depends on changed. Stages whose
+/// inputs are done run concurrently.
+class Pipeline {
+public:
+  struct Stage {
+    std::string name_;
+    std::vector<std::string> inputs_;
+    /// hash of everything the stage reads besides outputs of its inputs,
+    /// evaluated on the calling thread
+    std::function<uint64_t()> key_;
+    /// reports into its own share of the run's progress
+    std::function<void(algebra::ProgressContext &)> run_;
+    /// the stage edits what its key reads, the key is taken again once the
+    /// stage finished so its own edits do not make the next run dirty
+    bool keyAfterRun_ = false;
+  };
+
+  /// inputs have to be added first, which keeps stages in dependency order
+  void addStage(Stage stage);
+
+  /// runs targets and everything they depend on, rethrows the first error
+  /// after all started stages finished. Every needed stage gets an equal
+  /// share of progress, cancellation stops stages that did not start yet and
+  /// whatever running stages poll.
+  void run(const std::vector<std::string> &targets,
+           algebra::ProgressContext *progress = nullptr);
+
+  /// next run executes every stage again
+  void invalidate() { keys_.clear(); }
+
+private:
+  std::vector<Stage> stages_;
+  std::unordered_map<std::string, std::size_t> indices_;
+  /// key of the last successful run of a stage
+  std::unordered_map<std::string, uint64_t> keys_;
+
+  std::size_t indexOf(const std::string &name) const;
+  static void execute(const Stage &stage, bool dirty,
+                      algebra::ProgressContext &progress);
+};
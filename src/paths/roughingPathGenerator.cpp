@@ -7,10 +7,13 @@
 
 static constexpr float kRDPEpsilon = 0.001f;
 
-MillingPath RoughingPathGenerator::generate() {
+MillingPath
+RoughingPathGenerator::generate(algebra::ProgressContext *progress) {
   /// change later
 
-  auto milling_points = calculateRoughMillingPoints();
+  algebra::ProgressContext untracked;
+  auto milling_points =
+      calculateRoughMillingPoints(progress != nullptr ? *progress : untracked);
   return MillingPath(std::move(milling_points), *cutter_);
 }
 void RoughingPathGenerator::setHeightMap(const HeightMap *heightMap) {
@@ -20,8 +23,8 @@ void RoughingPathGenerator::setCutter(const Cutter *cutter) {
   cutter_ = cutter;
 }
 
-std::vector<algebra::Vec3f>
-RoughingPathGenerator::calculateRoughMillingPoints() const {
+std::vector<algebra::Vec3f> RoughingPathGenerator::calculateRoughMillingPoints(
+    algebra::ProgressContext &progress) const {
   std::vector<algebra::Vec3f> milling_points;
 
   const auto &block = heightMap_->block();
@@ -46,12 +49,17 @@ RoughingPathGenerator::calculateRoughMillingPoints() const {
   const uint32_t x_divisions = heightMap_->divisions().x_;
   const uint32_t z_divisions = heightMap_->divisions().z_;
 
+  /// two layers of segments_count strips each
+  int strips_done = 0;
+  const auto strips_total = static_cast<float>(2 * segments_count);
+
   auto roughing_layer = [&](const float min_height, bool reverse_layer) {
     int start_i = reverse_layer ? segments_count - 1 : 0;
     int end_i = reverse_layer ? -1 : segments_count;
     int step = reverse_layer ? -1 : 1;
 
     for (int i = start_i; i != end_i; i += step) {
+      progress.poll(static_cast<float>(strips_done++) / strips_total);
       const bool forward_x = (i % 2 == 0);
       float current_physical_z = bottom_z + (static_cast<float>(i) * dz);
 
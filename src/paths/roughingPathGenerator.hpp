@@ -3,15 +3,18 @@
 #include "cutter.hpp"
 #include "heightMap.hpp"
 #include "millingPath.hpp"
+#include "progress.hpp"
 
 class RoughingPathGenerator {
 public:
-  MillingPath generate();
+  MillingPath generate(algebra::ProgressContext *progress = nullptr);
   void setHeightMap(const HeightMap *heightMap);
   void setCutter(const Cutter *cutter);
 
 private:
   const HeightMap *heightMap_ = nullptr;
   const Cutter *cutter_ = nullptr;
-  std::vector<algebra::Vec3f> calculateRoughMillingPoints() const;
+  /// polls once per strip
+  std::vector<algebra::Vec3f>
+  calculateRoughMillingPoints(algebra::ProgressContext &progress) const;
 };
\ No newline at end of file
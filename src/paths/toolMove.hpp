@@ -0,0 +1,22 @@
+#pragma once
+
+#include "plane.hpp"
+#include "vec.hpp"
+#include <cstdint>
+
+/// Single G-code motion block in world coordinates. Arcs lie in a world
+/// plane (XZ is the machine XY plane, XY is the machine XZ plane) and turn
+/// counter clockwise when, in that plane's axis order, the angle grows.
+struct ToolMove {
+  enum class Type : uint8_t { Linear, Arc };
+
+  Type type_ = Type::Linear;
+  algebra::Vec3f end_;
+  algebra::Vec3f center_;
+  algebra::Plane plane_ = algebra::Plane::XZ;
+  bool counterClockwise_ = false;
+
+  static ToolMove linear(const algebra::Vec3f &end) {
+    return ToolMove{.type_ = Type::Linear, .end_ = end, .center_ = {}};
+  }
+};
@@ -12,7 +12,7 @@ public:
   virtual const IMeshable &getMesh() const = 0;
   virtual const algebra::Vec3f &getPosition() const = 0;
   virtual void updatePosition(const algebra::Vec3f &position) = 0;
-  const Color &getColor() { return _color; }
+  const Color &getColor() const { return _color; }
   void setColor(const Color &color) { _color = color; }
 
   //  virtual algebra::Vec3f &getPosition() = 0;
@@ -1,6 +1,7 @@
 #pragma once
 #include "IEntity.hpp"
 #include "glad/gl.h"
+#include "renderStats.hpp"
 #include <vector>
 
 class IEntityRenderer {
@@ -9,6 +10,13 @@ public:
   virtual void render(const std::vector<IEntity *> &entities) = 0;
 
 protected:
+  /// size in pixels of the viewport being drawn into
+  static algebra::Vec2f viewportSize() {
+    GLint viewport[4] = {};
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    return {static_cast<float>(viewport[2]), static_cast<float>(viewport[3])};
+  }
+
   GLuint prepareInstacedModelMatrices(const std::vector<IEntity *> &entities) {
     std::vector<algebra::Mat4f> modelMatrices;
     for (const auto &entity : entities) {
@@ -20,6 +28,7 @@ protected:
     glBindBuffer(GL_ARRAY_BUFFER, modelBuffer);
     glBufferData(GL_ARRAY_BUFFER, modelMatrices.size() * sizeof(algebra::Mat4f),
                  modelMatrices.data(), GL_DYNAMIC_DRAW);
+    RenderStats::instance().bufferUpload();
 
     for (int i = 0; i < 4; ++i) {
       glEnableVertexAttribArray(1 + i);
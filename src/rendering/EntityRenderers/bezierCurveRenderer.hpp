@@ -2,7 +2,6 @@
 
 #include "IEntityRenderer.hpp"
 #include "bezierCurve.hpp"
-#include "camera.hpp"
 #include "glfwHelper.hpp"
 #include "shader.hpp"
 
@@ -10,8 +9,8 @@
 
 class BezierCurveRenderer : public IEntityRenderer {
 public:
-  BezierCurveRenderer(const Camera &camera, GLFWwindow *window)
-      : _camera(camera), _window(window),
+  explicit BezierCurveRenderer(GLFWwindow *window)
+      : _window(window),
         _shader("../../resources/shaders/vertexBezier.vs",
                 "../../resources/shaders/geometryBezier.gs",
                 "../../resources/shaders/colorFragmentShader.hlsl") {}
@@ -21,8 +20,6 @@ public:
       return;
     }
     _shader.use();
-    _shader.setViewMatrix(_camera.viewMatrix());
-    _shader.setProjectionMatrix(_camera.getProjectionMatrix());
     _shader.setInt(
         "screenResolution",
         static_cast<int>(0.5f *
@@ -37,13 +34,14 @@ public:
       const auto &mesh = entity->getMesh();
       glLineWidth(2.0f);
       glBindVertexArray(mesh.getVAO());
+      RenderStats::instance().vertexArrayBind();
       glDrawArrays(GL_POINTS, 0, static_cast<int>(mesh.getIndicesLength()));
+      RenderStats::instance().drawCall();
       glBindVertexArray(0);
     }
   }
 
 private:
-  const Camera &_camera;
   GLFWwindow *_window;
   Shader _shader;
 };
\ No newline at end of file
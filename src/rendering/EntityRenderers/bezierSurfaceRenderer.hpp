@@ -1,14 +1,14 @@
 #pragma once
 
 #include "IEntityRenderer.hpp"
-#include "camera.hpp"
 #include "mesh.hpp"
+#include "renderQueue.hpp"
 #include "shader.hpp"
 #include "surfaceMeshRenderer.hpp"
 
 class BezierSurfaceRenderer : public IEntityRenderer {
 public:
-  explicit BezierSurfaceRenderer(const Camera &camera)
+  BezierSurfaceRenderer()
       : _shader(
             {ShaderPath{._path = "../../resources/shaders/vertexSurface.glsl",
                         ._type = GL_VERTEX_SHADER},
@@ -20,8 +20,7 @@ public:
                         ._type = GL_TESS_EVALUATION_SHADER},
              ShaderPath{
                  ._path = "../../resources/shaders/fragmentShaderTrimmed.hlsl",
-                 ._type = GL_FRAGMENT_SHADER}}),
-        _meshRenderer(camera), _camera(camera) {}
+                 ._type = GL_FRAGMENT_SHADER}}) {}
 
   void render(const std::vector<IEntity *> &entities) override {
     if (entities.empty()) {
@@ -29,42 +28,38 @@ public:
     }
 
     _shader.use();
-    _shader.setViewMatrix(_camera.viewMatrix());
-    _shader.setProjectionMatrix(_camera.getProjectionMatrix());
+    _shader.setVec2f("viewport", viewportSize());
+    _shader.setFloat("pixel_error", kPixelError);
+    // _shader.setInt("offset_surface", static_cast<int>(offsetSurface_));
+    _shader.setFloat("offset_surface", normalDirection_);
+    glPatchParameteri(GL_PATCH_VERTICES, 16);
 
+    /// both isoline directions are instances of one draw, the vertex
+    /// shader passes the instance on as the direction
+    _queue.clear();
     for (auto *entity : entities) {
-      const auto &bezierSurface = dynamic_cast<BezierSurface &>(*entity);
-      _shader.setVec4f("color", entity->getColor().toVector());
+      const auto &mesh = dynamic_cast<BezierSurface &>(*entity).getMesh();
+      _queue.push({.shader = &_shader,
+                   .vao = mesh.getVAO(),
+                   .primitive = GL_PATCHES,
+                   .count = static_cast<GLsizei>(mesh.getIndicesLength()),
+                   .instances = 2,
+                   .entity = entity});
+    }
+    _queue.submit([this](const RenderQueue::Item &item) {
+      const auto &bezierSurface =
+          dynamic_cast<const BezierSurface &>(*item.entity);
+      _shader.setVec4f("color", item.entity->getColor().toVector());
       _shader.setUInt("u_patches", bezierSurface.getPatches().rowCount);
       _shader.setUInt("v_patches", bezierSurface.getPatches().colCount);
       _shader.setUInt("u_subdivisions", bezierSurface.getMeshDensity().s);
       _shader.setUInt("v_subdivisions", bezierSurface.getMeshDensity().t);
       _shader.setInt("polyline", static_cast<int>(bezierSurface.wireframe()));
-      // _shader.setInt("offset_surface", static_cast<int>(offsetSurface_));
-      _shader.setFloat("offset_surface", normalDirection_);
-
-      const auto &mesh = bezierSurface.getMesh();
-      if (bezierSurface.isTrimmed()) {
-        _shader.setInt("trim", 1);
-      } else {
-        _shader.setInt("trim", 0);
-      }
+      _shader.setInt("trim", bezierSurface.isTrimmed() ? 1 : 0);
       if (bezierSurface.hasIntersectionTexture()) {
-        const auto &texture = bezierSurface.getIntersectionTexture();
-        texture.bind();
+        bezierSurface.getIntersectionTexture().bind();
       }
-      // glLineWidth(2.0f);
-
-      glPatchParameteri(GL_PATCH_VERTICES, 16);
-      glBindVertexArray(mesh.getVAO());
-      _shader.setUInt("direction", 0);
-
-      glDrawArrays(GL_PATCHES, 0, static_cast<int>(mesh.getIndicesLength()));
-
-      _shader.setUInt("direction", 1);
-      glDrawArrays(GL_PATCHES, 0, static_cast<int>(mesh.getIndicesLength()));
-      glBindVertexArray(0);
-    }
+    });
     _meshRenderer.render(entities);
   }
 
@@ -72,9 +67,13 @@ public:
   float &normalDirection() { return normalDirection_; }
 
 private:
+  /// screen-space error target of the adaptive tessellation, in pixels;
+  /// mesh density caps the number of isolines per patch
+  static constexpr float kPixelError = 0.5f;
+
   Shader _shader;
+  RenderQueue _queue;
   SurfaceMeshRenderer _meshRenderer;
-  const Camera &_camera;
   float normalDirection_ = 0.f;
   bool offsetSurface_;
 };
\ No newline at end of file
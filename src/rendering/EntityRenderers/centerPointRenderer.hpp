@@ -2,6 +2,7 @@
 
 #include "IRenderable.hpp"
 #include "camera.hpp"
+#include "renderStats.hpp"
 #include "shader.hpp"
 #include "texture.hpp"
 class CenterPointRenderer {
@@ -17,11 +18,9 @@ public:
     _texture->bind(0);
     _shader.use();
 
-    _shader.setViewMatrix(_camera.viewMatrix());
     _shader.setModelMatrix(
         renderable.getModelMatrix() *
         _camera.getSphericalPosition().getRotationMatrix().transpose());
-    _shader.setProjectionMatrix(_camera.getProjectionMatrix());
 
     const auto &mesh = renderable.getMesh();
 
@@ -31,7 +30,9 @@ public:
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     glBindVertexArray(mesh.getVAO());
+    RenderStats::instance().vertexArrayBind();
     glDrawElements(GL_TRIANGLES, mesh.getIndicesLength(), GL_UNSIGNED_INT, 0);
+    RenderStats::instance().drawCall();
     glBindVertexArray(0);
     glDisable(GL_BLEND);
   }
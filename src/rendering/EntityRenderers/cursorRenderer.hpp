@@ -24,18 +24,18 @@ public:
       auto scale_matrix = algebra::transformations::scaleMatrix(
           camera_distance, camera_distance, camera_distance);
 
-      _shader.setViewMatrix(_camera.viewMatrix());
       _shader.setModelMatrix(
           entity->getModelMatrix() * scale_matrix *
           _camera.getSphericalPosition().getRotationMatrix().transpose());
-      _shader.setProjectionMatrix(_camera.getProjectionMatrix());
 
       const auto &mesh = entity->getMesh();
 
       glEnable(GL_BLEND);
       glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
       glBindVertexArray(mesh.getVAO());
+      RenderStats::instance().vertexArrayBind();
       glDrawElements(GL_TRIANGLES, mesh.getIndicesLength(), GL_UNSIGNED_INT, 0);
+      RenderStats::instance().drawCall();
 
       glBindVertexArray(0);
       glDisable(GL_BLEND);
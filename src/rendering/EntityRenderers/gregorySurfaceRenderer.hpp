@@ -1,14 +1,14 @@
 #pragma once
 
 #include "IEntityRenderer.hpp"
-#include "camera.hpp"
 #include "gregoryMesh.hpp"
 #include "gregorySurface.hpp"
 #include "gregoryTangentVectorsRenderer.hpp"
+#include "renderQueue.hpp"
 #include <ranges>
 class GregorySurfaceRenderer : public IEntityRenderer {
 public:
-  explicit GregorySurfaceRenderer(const Camera &camera)
+  GregorySurfaceRenderer()
       : _shader(
             {ShaderPath{._path = "../../resources/shaders/vertexSurface.glsl",
                         ._type = GL_VERTEX_SHADER},
@@ -21,51 +21,51 @@ public:
 
              ShaderPath{._path =
                             "../../resources/shaders/colorFragmentShader.hlsl",
-                        ._type = GL_FRAGMENT_SHADER}}),
-        _tangentVectorRenderer(camera), _camera(camera) {}
+                        ._type = GL_FRAGMENT_SHADER}}) {}
 
   void render(const std::vector<IEntity *> &entities) override {
     if (entities.empty()) {
       return;
     }
     _shader.use();
-    _shader.setViewMatrix(_camera.viewMatrix());
-    _shader.setProjectionMatrix(_camera.getProjectionMatrix());
+    _shader.setVec2f("viewport", viewportSize());
+    _shader.setFloat("pixel_error", kPixelError);
+    glLineWidth(2.0f);
+    glPointSize(10.0f);
+    glPatchParameteri(GL_PATCH_VERTICES, 20);
 
+    /// one item per patch mesh, both isoline directions as two instances
+    _queue.clear();
     for (const auto &entity : entities) {
       auto &gregorySurface = dynamic_cast<GregorySurface &>(*entity);
-
-      const auto &meshDensities = gregorySurface.getMeshDensities();
-
-      glLineWidth(2.0f);
-      glPointSize(10.0f);
-      _shader.setVec4f("Color", entity->getColor().toVector());
-
       for (const auto &[i, mesh] :
            gregorySurface.getMeshes() | std::views::enumerate) {
-
-        _shader.setUInt("u_subdivisions", meshDensities[i].s);
-        _shader.setUInt("v_subdivisions", meshDensities[i].t);
-
-        glPatchParameteri(GL_PATCH_VERTICES, 20);
-        glBindVertexArray(mesh->getVAO());
-        _shader.setUInt("direction", 0);
-        glDrawArrays(GL_PATCHES, 0,
-                     static_cast<int>(mesh->getIndicesLength() / 3));
-        //  glDrawArrays(GL_POINTS, 0,
-        //  static_cast<int>(mesh->getIndicesLength()));
-
-        _shader.setUInt("direction", 1);
-        glDrawArrays(GL_PATCHES, 0,
-                     static_cast<int>(mesh->getIndicesLength() / 3));
-        glBindVertexArray(0);
+        _queue.push(
+            {.shader = &_shader,
+             .vao = mesh->getVAO(),
+             .primitive = GL_PATCHES,
+             .count = static_cast<GLsizei>(mesh->getIndicesLength() / 3),
+             .instances = 2,
+             .entity = entity,
+             .part = static_cast<uint32_t>(i)});
       }
     }
+    _queue.submit([this](const RenderQueue::Item &item) {
+      const auto &gregorySurface =
+          dynamic_cast<const GregorySurface &>(*item.entity);
+      const auto &density = gregorySurface.getMeshDensities()[item.part];
+      _shader.setVec4f("Color", item.entity->getColor().toVector());
+      _shader.setUInt("u_subdivisions", density.s);
+      _shader.setUInt("v_subdivisions", density.t);
+    });
     _tangentVectorRenderer.render(entities);
   }
 
 private:
+  /// same error target as BezierSurfaceRenderer
+  static constexpr float kPixelError = 0.5f;
+
   Shader _shader;
+  RenderQueue _queue;
   GregoryTangentVectorsRenderer _tangentVectorRenderer;
-  const Camera &_camera;
 };
\ No newline at end of file
@@ -2,7 +2,6 @@
 
 #include "IEntityRenderer.hpp"
 #include "bezierSurfaceC0.hpp"
-#include "camera.hpp"
 #include "gregorySurface.hpp"
 #include "mesh.hpp"
 #include "pointRenderer.hpp"
@@ -12,22 +11,19 @@
 
 class GregoryTangentVectorsRenderer : public IEntityRenderer {
 public:
-  explicit GregoryTangentVectorsRenderer(const Camera &camera)
+  GregoryTangentVectorsRenderer()
       : _shader(
             {ShaderPath{._path = "../../resources/shaders/vertexMesh.hlsl",
                         ._type = GL_VERTEX_SHADER},
              ShaderPath{._path =
                             "../../resources/shaders/colorFragmentShader.hlsl",
-                        ._type = GL_FRAGMENT_SHADER}}),
-        _camera(camera) {}
+                        ._type = GL_FRAGMENT_SHADER}}) {}
 
   void render(const std::vector<IEntity *> &entities) override {
     if (entities.empty()) {
       return;
     }
     _shader.use();
-    _shader.setViewMatrix(_camera.viewMatrix());
-    _shader.setProjectionMatrix(_camera.getProjectionMatrix());
 
     for (const auto &entity : entities) {
       const auto &gregorySurface = dynamic_cast<GregorySurface &>(*entity);
@@ -41,8 +37,10 @@ public:
         _shader.setVec4f("Color", colors[i]);
 
         glBindVertexArray(mesh->getVAO());
+        RenderStats::instance().vertexArrayBind();
         glDrawElements(GL_LINES, mesh->getIndicesLength(), GL_UNSIGNED_INT,
                        nullptr);
+        RenderStats::instance().drawCall();
       }
 
       glBindVertexArray(0);
@@ -51,7 +49,6 @@ public:
 
 private:
   Shader _shader;
-  const Camera &_camera;
   std::array<algebra::Vec4f, 3> colors{algebra::Vec4f{0.1f, .9f, 0.3f, 1.f},
                                        algebra::Vec4f{1.f, 0.f, 0.f, 0.f},
                                        algebra::Vec4f{.3f, 0.3f, .8f, 0.f}};
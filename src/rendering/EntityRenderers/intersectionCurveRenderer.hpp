@@ -13,8 +13,7 @@ public:
                         ._type = GL_VERTEX_SHADER},
              ShaderPath{._path =
                             "../../resources/shaders/colorFragmentShader.hlsl",
-                        ._type = GL_FRAGMENT_SHADER}}),
-        _camera(camera) {
+                        ._type = GL_FRAGMENT_SHADER}}) {
     firstPointRenderer_ = std::make_unique<CenterPointRenderer>(camera);
   }
 
@@ -22,16 +21,16 @@ public:
     if (entities.empty())
       return;
     _shader.use();
-    _shader.setViewMatrix(_camera.viewMatrix());
-    _shader.setProjectionMatrix(_camera.getProjectionMatrix());
     _shader.setVec4f("Color", _color);
     glLineWidth(3.0f);
 
     for (const auto &entity : entities) {
       const auto &mesh = entity->getMesh();
       glBindVertexArray(mesh.getVAO());
+      RenderStats::instance().vertexArrayBind();
       glDrawElements(GL_LINES, mesh.getIndicesLength(), GL_UNSIGNED_INT,
                      nullptr);
+      RenderStats::instance().drawCall();
       glBindVertexArray(0);
     }
     for (const auto &entity : entities) {
@@ -44,6 +43,5 @@ public:
 private:
   Shader _shader;
   std::unique_ptr<CenterPointRenderer> firstPointRenderer_;
-  const Camera &_camera;
   algebra::Vec4f _color{0.9f, .0f, 0.0f, 1.f};
 };
\ No newline at end of file
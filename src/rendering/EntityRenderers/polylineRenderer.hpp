@@ -1,40 +1,40 @@
 #pragma once
 
 #include "IEntityRenderer.hpp"
-#include "camera.hpp"
+#include "renderQueue.hpp"
 #include "shader.hpp"
 class PolylineRenderer : public IEntityRenderer {
 public:
-  explicit PolylineRenderer(const Camera &camera)
+  PolylineRenderer()
       : _shader(
             {ShaderPath{._path = "../../resources/shaders/vertexMesh.hlsl",
                         ._type = GL_VERTEX_SHADER},
              ShaderPath{._path =
                             "../../resources/shaders/colorFragmentShader.hlsl",
-                        ._type = GL_FRAGMENT_SHADER}}),
-        _camera(camera) {}
+                        ._type = GL_FRAGMENT_SHADER}}) {}
 
   void render(const std::vector<IEntity *> &entities) override {
     if (entities.empty())
       return;
     _shader.use();
-    _shader.setViewMatrix(_camera.viewMatrix());
-    _shader.setProjectionMatrix(_camera.getProjectionMatrix());
     _shader.setVec4f("Color", _color);
     glLineWidth(3.0f);
 
+    _queue.clear();
     for (const auto &entity : entities) {
       const auto &mesh = entity->getMesh();
-      glBindVertexArray(mesh.getVAO());
-      glDrawElements(GL_LINES, mesh.getIndicesLength(), GL_UNSIGNED_INT,
-                     nullptr);
-      glBindVertexArray(0);
+      _queue.push({.shader = &_shader,
+                   .vao = mesh.getVAO(),
+                   .primitive = GL_LINES,
+                   .count = static_cast<GLsizei>(mesh.getIndicesLength()),
+                   .indexed = true});
     }
+    _queue.submit([](const RenderQueue::Item &) {});
     glLineWidth(2.0f);
   }
 
 private:
   Shader _shader;
-  const Camera &_camera;
+  RenderQueue _queue;
   algebra::Vec4f _color{0.9f, .0f, 0.0f, 1.f};
 };
\ No newline at end of file
@@ -1,24 +1,20 @@
 #pragma once
 #include "IEntityRenderer.hpp"
-#include "camera.hpp"
 #include "shader.hpp"
 #include "torusEntity.hpp"
 #include <memory>
 
 class TorusRenderer : public IEntityRenderer {
 public:
-  explicit TorusRenderer(const Camera &camera)
+  TorusRenderer()
       : _shader("../../resources/shaders/torusShader.vs",
-                "../../resources/shaders/fragmentShaderTrimmed.hlsl"),
-        _camera(camera) {}
+                "../../resources/shaders/fragmentShaderTrimmed.hlsl") {}
 
   void render(const std::vector<IEntity *> &entities) override {
     if (entities.empty()) {
       return;
     }
     _shader.use();
-    _shader.setViewMatrix(_camera.viewMatrix());
-    _shader.setProjectionMatrix(_camera.getProjectionMatrix());
 
     for (const auto &entity : entities) {
       const auto &mesh = entity->getMesh();
@@ -35,13 +31,14 @@ public:
         texture.bind();
       }
       glBindVertexArray(mesh.getVAO());
+      RenderStats::instance().vertexArrayBind();
       _shader.setModelMatrix(entity->getModelMatrix());
       glDrawElements(GL_LINES, mesh.getIndicesLength(), GL_UNSIGNED_INT, 0);
+      RenderStats::instance().drawCall();
       glBindVertexArray(0);
     }
   }
 
 private:
   Shader _shader;
-  const Camera &_camera;
 };
\ No newline at end of file
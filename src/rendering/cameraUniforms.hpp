@@ -0,0 +1,43 @@
+#pragma once
+
+#include "camera.hpp"
+#include "glad/gl.h"
+#include "matrix.hpp"
+#include "renderStats.hpp"
+#include <array>
+
+/// View and projection shared by every shader through one uniform buffer,
+/// uploaded once per pass instead of by each renderer.
+class CameraUniforms {
+public:
+  /// binding of the `Camera` block declared by the shaders
+  static constexpr GLuint kBinding = 0;
+
+  CameraUniforms() {
+    glGenBuffers(1, &buffer_);
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer_);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(Matrices), nullptr,
+                 GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, kBinding, buffer_);
+  }
+  ~CameraUniforms() { glDeleteBuffers(1, &buffer_); }
+
+  CameraUniforms(const CameraUniforms &) = delete;
+  CameraUniforms &operator=(const CameraUniforms &) = delete;
+
+  /// uploads the current view and projection, std140 mat4 is column major
+  void update(const Camera &camera) {
+    const Matrices matrices = {camera.viewMatrix().transpose(),
+                               camera.getProjectionMatrix().transpose()};
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer_);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(Matrices), matrices.data());
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    RenderStats::instance().bufferUpload();
+  }
+
+private:
+  using Matrices = std::array<algebra::Mat4f, 2>;
+
+  GLuint buffer_{};
+};
@@ -2,6 +2,7 @@
 #include "shader.hpp"
 
 #include "camera.hpp"
+#include "renderStats.hpp"
 
 class GridRenderer {
 public:
@@ -15,8 +16,6 @@ public:
 
   void render(const Camera *camera) {
     shader_.use();
-    shader_.setViewMatrix(camera->viewMatrix());
-    shader_.setProjectionMatrix(camera->projectionMatrix());
     shader_.setVec3f("cameraWorldPos", camera->getPosition());
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float),
                           (void *)0);
@@ -29,7 +28,9 @@ public:
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     glBindVertexArray(vao_);
+    RenderStats::instance().vertexArrayBind();
     glDrawArrays(GL_TRIANGLES, 0, 6);
+    RenderStats::instance().drawCall();
     glBindVertexArray(0);
 
     /// clear depth and blending
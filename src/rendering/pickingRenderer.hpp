@@ -1,7 +1,7 @@
 #pragma once
 #include "IEntity.hpp"
-#include "camera.hpp"
 #include "pickingTexture.hpp"
+#include "renderStats.hpp"
 #include "shader.hpp"
 #include <memory>
 
@@ -12,7 +12,7 @@ public:
         _shader("../../resources/shaders/vertexPickingShader.hlsl",
                 "../../resources/shaders/pickingShader.frag") {}
 
-  void render(const std::vector<IEntity *> &entities, const Camera &camera) {
+  void render(const std::vector<IEntity *> &entities) {
 
     if (entities.empty()) {
       return;
@@ -21,17 +21,17 @@ public:
 
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     _shader.use();
-    _shader.setViewMatrix(camera.viewMatrix());
-    _shader.setProjectionMatrix(camera.projectionMatrix());
 
     const auto &sampleMesh = entities[0]->getMesh();
     glBindVertexArray(sampleMesh.getVAO());
+    RenderStats::instance().vertexArrayBind();
     auto mbuffer = preparePickingInstacedBuffers(entities);
 
     auto meshKind =
         entities[0]->getMeshKind() == MeshKind::Lines ? GL_LINES : GL_TRIANGLES;
     glDrawElementsInstanced(meshKind, sampleMesh.getIndicesLength(),
                             GL_UNSIGNED_INT, 0, entities.size());
+    RenderStats::instance().drawCall();
     glBindBuffer(GL_ARRAY_BUFFER, 0); // Unbind the buffer
     glBindVertexArray(0);
     glDeleteBuffers(1, &mbuffer);
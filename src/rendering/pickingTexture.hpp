@@ -1,6 +1,8 @@
 #pragma once
 #include "glad/gl.h"
+#include <cstddef>
 #include <cstdint>
+#include <span>
 #include <stdexcept>
 
 class PickingTexture {
@@ -17,6 +19,14 @@ public:
     if (_depthTexture != 0) {
       glDeleteTextures(1, &_depthTexture);
     }
+
+    if (_regionFence != nullptr) {
+      glDeleteSync(_regionFence);
+    }
+
+    if (_regionBuffer != 0) {
+      glDeleteBuffers(1, &_regionBuffer);
+    }
   }
 
   void init(unsigned int windowWidth, unsigned int windowHeight) {
@@ -68,8 +78,75 @@ public:
     return pixel;
   }
 
+  /// Starts copying the object ids of a rectangle into a pixel buffer in one
+  /// call, the GPU finishes it while the frame goes on. Replaces a read still
+  /// in flight.
+  void requestRegion(uint32_t x, uint32_t y, uint32_t width,
+                     uint32_t height) {
+    if (_regionBuffer == 0) {
+      glGenBuffers(1, &_regionBuffer);
+    }
+    if (_regionFence != nullptr) {
+      glDeleteSync(_regionFence);
+    }
+
+    const size_t size = size_t{width} * height * sizeof(uint32_t);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, _regionBuffer);
+    if (size > _regionCapacity) {
+      glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(size),
+                   nullptr, GL_STREAM_READ);
+      _regionCapacity = size;
+    }
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, _fbo);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glReadPixels(x, y, width, height, GL_RED_INTEGER, GL_UNSIGNED_INT,
+                 nullptr);
+    glReadBuffer(GL_NONE);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    _regionFence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    _regionSize = size;
+  }
+
+  bool regionPending() const { return _regionFence != nullptr; }
+
+  /// true once the requested copy landed, never blocks
+  bool regionReady() const {
+    if (_regionFence == nullptr) {
+      return false;
+    }
+    const GLenum status =
+        glClientWaitSync(_regionFence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+  }
+
+  /// Hands the object ids of a ready region to visit(std::span<const
+  /// uint32_t>) and releases it.
+  template <typename Visit> void consumeRegion(Visit visit) {
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, _regionBuffer);
+    const auto *ids = static_cast<const uint32_t *>(
+        glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0,
+                         static_cast<GLsizeiptr>(_regionSize),
+                         GL_MAP_READ_BIT));
+    if (ids != nullptr) {
+      visit(std::span<const uint32_t>(ids, _regionSize / sizeof(uint32_t)));
+      glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    glDeleteSync(_regionFence);
+    _regionFence = nullptr;
+  }
+
 private:
   uint32_t _fbo = 0;
   uint32_t _pickingTexture = 0;
   uint32_t _depthTexture = 0;
+
+  uint32_t _regionBuffer = 0;
+  size_t _regionCapacity = 0;
+  size_t _regionSize = 0;
+  GLsync _regionFence = nullptr;
 };
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "glad/gl.h"
+#include "renderStats.hpp"
+#include "shader.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+class IEntity;
+
+/// Draws of one pass ordered by the state they need. The sort key packs
+/// program, primitive and vertex array, most costly to change first, so
+/// items sharing state end up next to each other and submit() binds it once
+/// per run of items instead of once per item.
+class RenderQueue {
+public:
+  struct Item {
+    const Shader *shader = nullptr;
+    GLuint vao = 0;
+    GLenum primitive = GL_TRIANGLES;
+    /// vertices, or indices when indexed
+    GLsizei count = 0;
+    /// element draw over GL_UNSIGNED_INT indices, array draw otherwise
+    bool indexed = false;
+    GLsizei instances = 1;
+    /// whose uniforms are set before the draw, part picks one of its meshes
+    const IEntity *entity = nullptr;
+    uint32_t part = 0;
+  };
+
+  void clear() { entries_.clear(); }
+  bool empty() const { return entries_.empty(); }
+  void push(const Item &item) { entries_.push_back({key(item), item}); }
+
+  /// Sorts and draws everything pushed, keeping push order among equal
+  /// keys. setUniforms(item) runs before each draw with its program current.
+  template <typename SetUniforms> void submit(SetUniforms setUniforms) {
+    std::ranges::stable_sort(entries_, {}, &Entry::key);
+
+    auto &stats = RenderStats::instance();
+    const Shader *shader = nullptr;
+    GLuint vao = 0;
+    bool vao_bound = false;
+    for (const auto &[key, item] : entries_) {
+      if (item.shader != shader) {
+        shader = item.shader;
+        shader->use();
+      }
+      if (!vao_bound || item.vao != vao) {
+        vao = item.vao;
+        vao_bound = true;
+        glBindVertexArray(vao);
+        stats.vertexArrayBind();
+      }
+
+      setUniforms(item);
+      if (item.indexed) {
+        glDrawElementsInstanced(item.primitive, item.count, GL_UNSIGNED_INT,
+                                nullptr, item.instances);
+      } else {
+        glDrawArraysInstanced(item.primitive, 0, item.count, item.instances);
+      }
+      stats.drawCall();
+    }
+    if (vao_bound) {
+      glBindVertexArray(0);
+    }
+  }
+
+private:
+  struct Entry {
+    uint64_t key;
+    Item item;
+  };
+  std::vector<Entry> entries_;
+
+  static uint64_t key(const Item &item) {
+    return uint64_t{item.shader->id()} << 40 |
+           uint64_t{item.primitive & 0xFFu} << 32 | uint64_t{item.vao};
+  }
+};
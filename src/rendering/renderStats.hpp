@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+
+/// GL work submitted per frame, counted where it is issued so the effect of
+/// batching and state sorting can be checked in the GUI. ImGui's own draws
+/// are not included.
+class RenderStats {
+public:
+  struct Counters {
+    uint32_t drawCalls_ = 0;
+    uint32_t programBinds_ = 0;
+    uint32_t vertexArrayBinds_ = 0;
+    uint32_t uniformUpdates_ = 0;
+    uint32_t bufferUploads_ = 0;
+  };
+
+  static RenderStats &instance() {
+    static RenderStats stats;
+    return stats;
+  }
+
+  void drawCall() { ++current_.drawCalls_; }
+  void programBind() { ++current_.programBinds_; }
+  void vertexArrayBind() { ++current_.vertexArrayBinds_; }
+  void uniformUpdate() { ++current_.uniformUpdates_; }
+  void bufferUpload() { ++current_.bufferUploads_; }
+
+  /// call once per frame before rendering, publishes the previous frame
+  void beginFrame() { lastFrame_ = std::exchange(current_, {}); }
+  const Counters &lastFrame() const { return lastFrame_; }
+
+private:
+  Counters current_;
+  Counters lastFrame_;
+};
@@ -6,6 +6,7 @@
 #include "bezierSurfaceC0.hpp"
 #include "bezierSurfaceRenderer.hpp"
 #include "camera.hpp"
+#include "cameraUniforms.hpp"
 #include "centerPointRenderer.hpp"
 #include "cursor.hpp"
 #include "cursorRenderer.hpp"
@@ -19,12 +20,16 @@
 #include "pickingTexture.hpp"
 #include "pointRenderer.hpp"
 #include "polylineRenderer.hpp"
+#include "profiler.hpp"
 #include "selectionBoxRenderer.hpp"
+#include "stockRenderer.hpp"
 #include "torusRenderer.hpp"
 
+#include <array>
 #include <cstdio>
+#include <initializer_list>
 #include <memory>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #define GLFW_INCLUDE_NONE
@@ -37,51 +42,42 @@ public:
   SceneRenderer(Camera *camera, PickingTexture &pickingTexture,
                 GLFWwindow *window)
       : _centerPointRenderer(*camera), _pickingRenderer(pickingTexture),
-        _selectedPointsRenderer(*camera,
-                                algebra::Vec4f{0.0f, 0.9f, 0.9f, 1.0f}),
-        _camera(camera), _window(window), millingPathRenderer_(camera) {
+        _selectedPointsRenderer(algebra::Vec4f{0.0f, 0.9f, 0.9f, 1.0f}),
+        _camera(camera), _window(window) {
     initEntityRenderers();
   }
 
-  void render(const std::unordered_map<EntityType, std::vector<IEntity *>>
-                  &groupedEntities) {
-    _camera->updateProjectionMatrix(_camera->projectionMatrix());
+  void render(const EntityGroups &groupedEntities) {
+    PROFILE_SCOPE("SceneRenderer::render");
+    useProjection(_camera->projectionMatrix());
     gridRenderer_.render(_camera);
-    for (const auto &entityGroup : groupedEntities) {
-      auto &renderer = _entityRenderers.at(entityGroup.first);
-      renderer->render(entityGroup.second);
-    }
+    renderEntityGroups(groupedEntities);
   }
 
-  void stereoscopicRender(
-      const std::unordered_map<EntityType, std::vector<IEntity *>>
-          &groupedEntities) {
+  void stereoscopicRender(const EntityGroups &groupedEntities) {
+    PROFILE_SCOPE("SceneRenderer::stereoscopicRender");
+    useProjection(_camera->projectionMatrix());
     gridRenderer_.render(_camera);
-    _camera->updateProjectionMatrix(_camera->leftEyeProjectionMatrix());
+    useProjection(_camera->leftEyeProjectionMatrix());
     glColorMask(GL_TRUE, GL_FALSE, GL_FALSE, GL_FALSE);
 
-    for (const auto &entityGroup : groupedEntities) {
-      auto &renderer = _entityRenderers.at(entityGroup.first);
-      renderer->render(entityGroup.second);
-    }
+    renderEntityGroups(groupedEntities);
     glClear(GL_DEPTH_BUFFER_BIT);
-    _camera->updateProjectionMatrix(_camera->RightEyeProjectionMatrix());
+    useProjection(_camera->RightEyeProjectionMatrix());
 
     glColorMask(GL_FALSE, GL_TRUE, GL_TRUE, GL_FALSE);
-    for (const auto &entityGroup : groupedEntities) {
-      auto &renderer = _entityRenderers.at(entityGroup.first);
-      renderer->render(entityGroup.second);
-    }
-    _camera->updateProjectionMatrix(_camera->projectionMatrix());
+    renderEntityGroups(groupedEntities);
+    /// passes drawn after the scene use the centered projection
+    useProjection(_camera->projectionMatrix());
     glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_FALSE);
   }
 
   void renderPicking(const std::vector<IEntity *> &pickableEntities) {
-    _pickingRenderer.render(pickableEntities, *_camera);
+    PROFILE_SCOPE("SceneRenderer::renderPicking");
+    _pickingRenderer.render(pickableEntities);
   }
   void renderCursor(Cursor *cursor) {
-    auto &cursorRenderer = _entityRenderers.at(EntityType::Cursor);
-    cursorRenderer->render({cursor});
+    getEntityRenderer(EntityType::Cursor).render({cursor});
   }
 
   void renderCenterPoint(const IRenderable &centerPoint) {
@@ -89,13 +85,12 @@ public:
   }
 
   void renderVirtualPoints(const std::vector<IEntity *> &virtualPoints) {
-    auto &virtualPointRenderer = _entityRenderers.at(EntityType::VirtualPoint);
-    virtualPointRenderer->render(virtualPoints);
+    getEntityRenderer(EntityType::VirtualPoint).render(virtualPoints);
   }
 
   void renderSelectionBox(const Mouse &mouse) {
     if (mouse._isSelectionBoxActive)
-      _selectionBoxRenderer.render(*_camera, mouse, _window);
+      _selectionBoxRenderer.render(mouse, _window);
   }
 
   void renderSelectedPoints(const std::vector<IEntity *> &selectedPoints) {
@@ -103,19 +98,32 @@ public:
   }
 
   IEntityRenderer &getEntityRenderer(const EntityType &entityType) {
-    return *_entityRenderers.at(entityType);
+    return *rendererOf_[static_cast<size_t>(entityType)];
   }
 
   void renderMillingPaths(const std::vector<const NamedPath *> &paths) {
+    PROFILE_SCOPE("SceneRenderer::renderMillingPaths");
     for (const auto &path : paths) {
       millingPathRenderer_.render(*path);
     }
   }
 
-private:
-  std::unordered_map<EntityType, std::unique_ptr<IEntityRenderer>>
-      _entityRenderers;
+  void renderStock(StockSimulation *simulation) {
+    PROFILE_SCOPE("SceneRenderer::renderStock");
+    if (simulation) {
+      stockRenderer_.render(*simulation);
+    }
+  }
 
+private:
+  /// submission order, each renderer is used once per pass
+  std::vector<std::unique_ptr<IEntityRenderer>> renderers_;
+  /// renderer of every entity type, types drawn alike share one
+  std::array<IEntityRenderer *, kEntityTypeCount> rendererOf_{};
+  /// entities of all types drawn by one renderer, reused between passes
+  std::vector<IEntity *> batch_;
+
+  CameraUniforms cameraUniforms_;
   CenterPointRenderer _centerPointRenderer;
   PickingRenderer _pickingRenderer;
   SelectionBoxRenderer _selectionBoxRenderer;
@@ -124,42 +132,60 @@ private:
   GLFWwindow *_window;
   GridRenderer gridRenderer_;
   MillingPathRenderer millingPathRenderer_;
+  StockRenderer stockRenderer_;
+
+  void useProjection(const algebra::Mat4f &projection) {
+    _camera->updateProjectionMatrix(projection);
+    cameraUniforms_.update(*_camera);
+  }
+
+  /// Renders the entities of every type a renderer draws in one call, so
+  /// shader state is set once per renderer rather than once per type.
+  void renderEntityGroups(const EntityGroups &groupedEntities) {
+    for (const auto &renderer : renderers_) {
+      batch_.clear();
+      for (size_t type = 0; type < groupedEntities.size(); ++type) {
+        if (rendererOf_[type] == renderer.get()) {
+          batch_.insert(batch_.end(), groupedEntities[type].begin(),
+                        groupedEntities[type].end());
+        }
+      }
+      if (!batch_.empty()) {
+        renderer->render(batch_);
+      }
+    }
+  }
+
+  void addRenderer(std::unique_ptr<IEntityRenderer> renderer,
+                   std::initializer_list<EntityType> types) {
+    for (auto type : types) {
+      rendererOf_[static_cast<size_t>(type)] = renderer.get();
+    }
+    renderers_.push_back(std::move(renderer));
+  }
 
   void initEntityRenderers() {
-    _entityRenderers.insert(
-        {EntityType::Torus, std::make_unique<TorusRenderer>(*_camera)});
-    _entityRenderers.insert(
-        {EntityType::Point,
-         std::make_unique<PointRenderer>(
-             *_camera, algebra::Vec4f{0.2f, 0.5f, 0.5f, 1.0f})});
-    _entityRenderers.insert(
-        {EntityType::VirtualPoint,
-         std::make_unique<PointRenderer>(
-             *_camera, algebra::Vec4f{0.0f, 0.8f, 0.0f, 1.0f})});
-    _entityRenderers.insert(
-        {EntityType::Cursor, std::make_unique<CursorRenderer>(*_camera)});
-    _entityRenderers.insert(
-        {EntityType::BezierCurveC0,
-         std::make_unique<BezierCurveRenderer>(*_camera, _window)});
-    _entityRenderers.insert(
-        {EntityType::BSplineCurve,
-         std::make_unique<BezierCurveRenderer>(*_camera, _window)});
-    _entityRenderers.insert(
-        {EntityType::InterpolatingSplineCurve,
-         std::make_unique<BezierCurveRenderer>(*_camera, _window)});
-    _entityRenderers.insert(
-        {EntityType::BezierSurfaceC0,
-         std::make_unique<BezierSurfaceRenderer>(*_camera)});
-    _entityRenderers.insert(
-        {EntityType::BezierSurfaceC2,
-         std::make_unique<BezierSurfaceRenderer>(*_camera)});
-    _entityRenderers.insert(
-        {EntityType::GregorySurface,
-         std::make_unique<GregorySurfaceRenderer>(*_camera)});
-    _entityRenderers.insert(
-        {EntityType::Polyline, std::make_unique<PolylineRenderer>(*_camera)});
-    _entityRenderers.insert(
-        {EntityType::IntersectionCurve,
-         std::make_unique<IntersectionCurveRenderer>(*_camera)});
-  }
-};
\ No newline at end of file
+    addRenderer(std::make_unique<TorusRenderer>(), {EntityType::Torus});
+    addRenderer(std::make_unique<PointRenderer>(
+                    algebra::Vec4f{0.2f, 0.5f, 0.5f, 1.0f}),
+                {EntityType::Point});
+    addRenderer(std::make_unique<PointRenderer>(
+                    algebra::Vec4f{0.0f, 0.8f, 0.0f, 1.0f}),
+                {EntityType::VirtualPoint});
+    addRenderer(std::make_unique<CursorRenderer>(*_camera),
+                {EntityType::Cursor});
+    addRenderer(std::make_unique<BezierCurveRenderer>(_window),
+                {EntityType::BezierCurveC0, EntityType::BSplineCurve,
+                 EntityType::InterpolatingSplineCurve});
+    /// separate, the GUI offsets C0 and C2 surfaces in opposite directions
+    addRenderer(std::make_unique<BezierSurfaceRenderer>(),
+                {EntityType::BezierSurfaceC0});
+    addRenderer(std::make_unique<BezierSurfaceRenderer>(),
+                {EntityType::BezierSurfaceC2});
+    addRenderer(std::make_unique<GregorySurfaceRenderer>(),
+                {EntityType::GregorySurface});
+    addRenderer(std::make_unique<PolylineRenderer>(), {EntityType::Polyline});
+    addRenderer(std::make_unique<IntersectionCurveRenderer>(*_camera),
+                {EntityType::IntersectionCurve});
+  }
+};
@@ -1,19 +1,17 @@
 #pragma once
 
 #include "GLFW/glfw3.h"
-#include "camera.hpp"
 #include "glfwHelper.hpp"
 #include "mouse.hpp"
+#include "renderStats.hpp"
 #include "shader.hpp"
 class SelectionBoxRenderer {
 public:
   SelectionBoxRenderer()
       : _shader("../../resources/shaders/selectionBoxVS.glsl",
                 "../../resources/shaders/selectionBoxFS.glsl") {}
-  void render(const Camera &camera, const Mouse &mouse, GLFWwindow *window) {
+  void render(const Mouse &mouse, GLFWwindow *window) {
     _shader.use();
-    _shader.setViewMatrix(camera.viewMatrix());
-    _shader.setProjectionMatrix(camera.projectionMatrix());
 
     auto startPos = mouse.getLastClickedPosition();
     auto endPos = mouse.getCurrentPosition();
@@ -37,7 +35,9 @@ public:
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     glBindVertexArray(1);
+    RenderStats::instance().vertexArrayBind();
     glDrawArrays(GL_TRIANGLES, 0, 6);
+    RenderStats::instance().drawCall();
     glBindVertexArray(0);
     glDisable(GL_BLEND);
   }
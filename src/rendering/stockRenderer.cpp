@@ -0,0 +1,91 @@
+#include "stockRenderer.hpp"
+#include "renderStats.hpp"
+#include "shader.hpp"
+#include "stockSimulation.hpp"
+#include "vec.hpp"
+
+StockRenderer::StockRenderer()
+    : shader_("../../resources/shaders/stock.vert",
+              "../../resources/shaders/stock.frag") {
+  glGenVertexArrays(1, &vao_);
+}
+
+StockRenderer::~StockRenderer() {
+  glDeleteVertexArrays(1, &vao_);
+  if (texture_ != 0) {
+    glDeleteTextures(1, &texture_);
+  }
+}
+
+void StockRenderer::render(StockSimulation &simulation) {
+  upload(simulation);
+
+  const auto &dimensions = simulation.stock().block().dimensions_;
+
+  shader_.use();
+  shader_.setVec2f("blockSize", {dimensions.x_, dimensions.z_});
+  shader_.setFloat("heightOffset", heightOffset_);
+  shader_.setVec4f("color", color_);
+  shader_.setInt("heights", 0);
+
+  glActiveTexture(GL_TEXTURE0);
+  glBindTexture(GL_TEXTURE_2D, texture_);
+
+  glEnable(GL_DEPTH_TEST);
+  glClear(GL_DEPTH_BUFFER_BIT);
+
+  glBindVertexArray(vao_);
+  RenderStats::instance().vertexArrayBind();
+  glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, static_cast<GLsizei>(2 * width_),
+                        static_cast<GLsizei>(height_ - 1));
+  RenderStats::instance().drawCall();
+  glBindVertexArray(0);
+
+  glDisable(GL_DEPTH_TEST);
+}
+
+void StockRenderer::upload(StockSimulation &simulation) {
+  const auto &stock = simulation.stock();
+  const auto &divisions = stock.divisions();
+
+  if (texture_ == 0 || width_ != divisions.x_ || height_ != divisions.z_) {
+    if (texture_ == 0) {
+      glGenTextures(1, &texture_);
+    }
+    width_ = divisions.x_;
+    height_ = divisions.z_;
+
+    glBindTexture(GL_TEXTURE_2D, texture_);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, static_cast<GLsizei>(width_),
+                 static_cast<GLsizei>(height_), 0, GL_RED, GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    uploaded_ = nullptr;
+  }
+
+  if (uploaded_ != &simulation) {
+    simulation.dirtyTiles().markAll();
+    uploaded_ = &simulation;
+  }
+
+  const auto tiles = simulation.dirtyTiles().take();
+  if (tiles.empty()) {
+    return;
+  }
+
+  const float *heights = stock.heights().data();
+
+  glBindTexture(GL_TEXTURE_2D, texture_);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(width_));
+  for (const auto &tile : tiles) {
+    glTexSubImage2D(GL_TEXTURE_2D, 0, static_cast<GLint>(tile.x),
+                    static_cast<GLint>(tile.z),
+                    static_cast<GLsizei>(tile.width),
+                    static_cast<GLsizei>(tile.height), GL_RED, GL_FLOAT,
+                    heights + static_cast<size_t>(tile.z) * width_ + tile.x);
+  }
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+}
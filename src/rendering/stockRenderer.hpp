@@ -0,0 +1,35 @@
+#pragma once
+
+#include "shader.hpp"
+#include "stockSimulation.hpp"
+#include "vec.hpp"
+#include <cstdint>
+
+/// Draws simulated stock as a grid displaced by an R32F height texture.
+/// Only tiles the simulation marked dirty are re-uploaded each frame; the
+/// grid itself has no vertex buffers, every row is an instanced triangle
+/// strip addressed by gl_VertexID and gl_InstanceID.
+class StockRenderer {
+public:
+  StockRenderer();
+  ~StockRenderer();
+
+  StockRenderer(const StockRenderer &) = delete;
+  StockRenderer &operator=(const StockRenderer &) = delete;
+
+  void render(StockSimulation &simulation);
+
+private:
+  Shader shader_;
+  algebra::Vec4f color_{0.75f, 0.7f, 0.6f, 1.f};
+  /// heights keep the block bottom at 0, the model sits on the 1.5 cm base
+  float heightOffset_ = -1.5f;
+
+  uint32_t vao_{};
+  uint32_t texture_{};
+  uint32_t width_ = 0;
+  uint32_t height_ = 0;
+  const StockSimulation *uploaded_ = nullptr;
+
+  void upload(StockSimulation &simulation);
+};
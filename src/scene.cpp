@@ -4,27 +4,34 @@
 #include "ISubscriber.hpp"
 #include "bSplineCurve.hpp"
 #include "bezierSurface.hpp"
-#include "camera.hpp"
 #include "entitiesTypes.hpp"
 #include "gregorySurface.hpp"
 #include "intersectionCurve.hpp"
 #include "pointEntity.hpp"
+#include "profiler.hpp"
+#include "updateScheduler.hpp"
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
-
-std::vector<IEntity *> Scene::getEntites() const {
-  std::vector<IEntity *> entities;
-  for (const auto &specific_entities : entities_) {
-    for (const auto &specifc_entity : specific_entities.second) {
-      entities.push_back(specifc_entity.get());
-    }
-  }
-  return entities;
-}
-
-void Scene::addEntity(EntityType entityType, std::unique_ptr<IEntity> entity) {
-  entities_[entityType].emplace_back(std::move(entity));
+#include <optional>
+#include <unordered_set>
+#include <vector>
+
+Scene::EntityHandle Scene::addEntity(EntityType entityType,
+                                     std::unique_ptr<IEntity> entity) {
+  const auto type = static_cast<size_t>(entityType);
+  auto *entity_ptr = entity.get();
+
+  const EntityHandle handle{entityType,
+                            storage_[type].insert(std::move(entity))};
+  groups_[type].push_back(entity_ptr);
+  entities_.push_back(entity_ptr);
+  handles_.emplace(entity_ptr, handle);
+  ids_[type].try_emplace(entity_ptr->getId(), entity_ptr);
+  ++revision_;
+  return handle;
 }
 
 Camera *Scene::getCamera() { return camera_; }
@@ -35,99 +42,103 @@ void Scene::removeEntities(std::vector<const IEntity *> &entitiesToRemove) {
   }
 
   enqueueSurfacePoints(entitiesToRemove);
-  for (auto it = entities_.begin(); it != entities_.end();) {
-    auto &vec = it->second;
-
-    auto new_end = std::ranges::remove_if(vec, [&](const auto &e) {
-      return std::ranges::find(entitiesToRemove, e.get()) !=
-             entitiesToRemove.end();
-    });
-    vec.erase(new_end.begin(), vec.end());
-
-    if (vec.empty()) {
-      it = entities_.erase(it);
-    } else {
-      ++it;
+  std::unordered_set<const IEntity *> removed;
+  for (const auto *entity : entitiesToRemove) {
+    if (removeEntity(entity)) {
+      removed.insert(entity);
     }
   }
+  std::erase_if(entities_,
+                [&removed](const IEntity *e) { return removed.contains(e); });
+  refreshPickables();
 }
 
-std::unordered_map<EntityType, std::vector<IEntity *>>
-Scene::getGroupedEntities() const {
-  std::unordered_map<EntityType, std::vector<IEntity *>> grouped_entities;
+bool Scene::removeEntity(const IEntity *entity) {
+  /// the same entity may be queued more than once
+  const auto it = handles_.find(entity);
+  if (it == handles_.end()) {
+    return false;
+  }
+  const auto [type, slot] = it->second;
+  handles_.erase(it);
+  ++revision_;
+
+  auto &ids = ids_[static_cast<size_t>(type)];
+  if (const auto id = ids.find(entity->getId());
+      id != ids.end() && id->second == entity) {
+    ids.erase(id);
+  }
 
-  for (const auto &pair : entities_) {
-    std::vector<IEntity *> specific_entities;
-    specific_entities.reserve(pair.second.size());
+  auto &group = groups_[static_cast<size_t>(type)];
+  const size_t hole = storage_[static_cast<size_t>(type)].erase(slot);
+  group[hole] = group.back();
+  group.pop_back();
+  return true;
+}
 
-    for (const auto &entity : pair.second) {
-      specific_entities.push_back(entity.get());
-    }
-    grouped_entities.insert({pair.first, specific_entities});
+IEntity *Scene::getEntity(EntityHandle handle) const {
+  const auto *entity =
+      storage_[static_cast<size_t>(handle.type)].get(handle.slot);
+  return entity != nullptr ? entity->get() : nullptr;
+}
+
+std::optional<Scene::EntityHandle>
+Scene::getHandle(const IEntity *entity) const {
+  const auto it = handles_.find(entity);
+  if (it == handles_.end()) {
+    return std::nullopt;
   }
+  return it->second;
+}
 
-  return grouped_entities;
+bool Scene::contains(const IEntity *entity) const {
+  return handles_.contains(entity);
 }
 
-std::vector<IEntity *> Scene::getPickables() const {
-  auto points = getPoints();
-  auto virtual_points = getVirtualPoints();
-  points.insert(points.begin(), virtual_points.begin(), virtual_points.end());
+IEntity *Scene::findById(EntityType entityType, uint32_t id) const {
+  const auto &ids = ids_[static_cast<size_t>(entityType)];
+  const auto it = ids.find(id);
+  return it != ids.end() ? it->second : nullptr;
+}
 
-  return points;
+const std::vector<IEntity *> &
+Scene::getEntities(EntityType entityType) const {
+  return groups_[static_cast<size_t>(entityType)];
 }
 
-std::vector<IEntity *> Scene::getVirtualPoints() const {
-  std::vector<IEntity *> virtual_points;
-  if (!entities_.contains(EntityType::BSplineCurve)) {
-    return virtual_points;
-  }
+const std::vector<IEntity *> &Scene::getPoints() const {
+  return getEntities(EntityType::Point);
+}
 
-  for (const auto &entity : entities_.at(EntityType::BSplineCurve)) {
-    auto *b_spline = dynamic_cast<BSplineCurve *>(entity.get());
+void Scene::refreshPickables() {
+  virtualPoints_.clear();
+  for (auto *entity : getEntities(EntityType::BSplineCurve)) {
+    auto *b_spline = dynamic_cast<BSplineCurve *>(entity);
     if (!b_spline || !b_spline->showBezierPoints()) {
       continue;
     }
 
-    const auto &bezier_virtual_points = b_spline->getVirtualPoints();
-    virtual_points.insert(virtual_points.end(), bezier_virtual_points.begin(),
-                          bezier_virtual_points.end());
-  }
-
-  return virtual_points;
-}
-
-std::vector<IEntity *> Scene::getPoints() const {
-  std::vector<IEntity *> points;
-  if (!entities_.contains(EntityType::Point)) {
-    return points;
-  }
-
-  points.reserve(entities_.at(EntityType::Point).size());
-  for (const auto &point : entities_.at(EntityType::Point)) {
-    points.push_back(point.get());
+    for (const auto &virtual_point : b_spline->bezierPoints()) {
+      virtualPoints_.push_back(virtual_point.get());
+    }
   }
 
-  return points;
+  const auto &points = getPoints();
+  pickables_.clear();
+  pickables_.insert(pickables_.end(), virtualPoints_.begin(),
+                    virtualPoints_.end());
+  pickables_.insert(pickables_.end(), points.begin(), points.end());
 }
 
 void Scene::enqueueSurfacePoints(
     std::vector<const IEntity *> &entitiesToRemove) const {
-  const auto &points = getPoints();
   std::vector<IEntity *> points_to_remove;
 
   for (const auto &entity : entitiesToRemove) {
     if (auto *surface = dynamic_cast<const BezierSurface *>(entity)) {
       const auto &surface_points = surface->getPoints();
       for (const auto &surface_point : surface_points) {
-        const auto it =
-            std::ranges::find_if(points, [&surface_point](const auto &point) {
-              return point->getId() == surface_point.get().getId();
-            });
-
-        if (it != points.end()) {
-          points_to_remove.push_back(*it);
-        }
+        points_to_remove.push_back(&surface_point.get());
       }
     }
   }
@@ -142,23 +153,15 @@ void Scene::enqueueSurfacePoints(
 /// 2. entities could somehow be added to killing queue
 ///
 void Scene::enqueueDeadGregoryPatches() {
-  if (!entities_.contains(EntityType::GregorySurface)) {
-    return;
-  }
-
-  for (const auto &entity : entities_.at(EntityType::GregorySurface)) {
-    auto *gregory = dynamic_cast<GregorySurface *>(entity.get());
+  for (auto *entity : getEntities(EntityType::GregorySurface)) {
+    auto *gregory = dynamic_cast<GregorySurface *>(entity);
     if (gregory->isDead()) {
       deadEntities_.push_back(gregory);
     }
   }
 
-  if (!entities_.contains(EntityType::IntersectionCurve)) {
-    return;
-  }
-
-  for (const auto &entity : entities_.at(EntityType::IntersectionCurve)) {
-    auto *gregory = dynamic_cast<IntersectionCurve *>(entity.get());
+  for (auto *entity : getEntities(EntityType::IntersectionCurve)) {
+    auto *gregory = dynamic_cast<IntersectionCurve *>(entity);
     if (gregory->isDead()) {
       deadEntities_.push_back(gregory);
     }
@@ -182,29 +185,22 @@ IEntity *Scene::contractEdge(const PointEntity &p1, const PointEntity &p2) {
 
 void Scene::rebindReferences(const PointEntity &oldPoint,
                              PointEntity &newPoint) {
-  for (auto &pair : entities_) {
-    if (pair.first == EntityType::Point || pair.first == EntityType::Torus ||
-        pair.first == EntityType::GregorySurface) {
+  /// subscribers of a point are exactly the entities depending on it, so
+  /// only those get touched; unsubscribing edits the list, hence the copy
+  const auto subscribers = oldPoint.getSubscribers();
+  for (const auto &sub : subscribers) {
+    auto &subscriber = sub.get();
+    subscriber.unsubscribe(oldPoint);
+    subscriber.subscribe(newPoint);
+
+    auto *grouped_entity = dynamic_cast<IGroupedEntity *>(&subscriber);
+    if (grouped_entity == nullptr) {
       continue;
     }
 
-    for (const auto &sub : oldPoint.getSubscribers()) {
-      sub.get().subscribe(newPoint);
-      sub.get().unsubscribe(oldPoint);
-    }
-    auto &entities = pair.second;
-    for (auto &entitity : entities) {
-      auto *grouped_entity = dynamic_cast<IGroupedEntity *>(entitity.get());
-
-      if (grouped_entity == nullptr) {
-        return;
-      }
-
-      auto &points = grouped_entity->getPointsReferences();
-      for (auto &point_ref : points) {
-        if (point_ref.get().getId() == oldPoint.getId()) {
-          point_ref = std::ref(newPoint);
-        }
+    for (auto &point_ref : grouped_entity->getPointsReferences()) {
+      if (&point_ref.get() == &oldPoint) {
+        point_ref = std::ref(newPoint);
       }
     }
   }
@@ -218,19 +214,11 @@ void Scene::removeDeadEntities() {
   deadEntities_.clear();
 }
 
-void Scene::updateDirtyEntities() {
-  for (const auto &entity_type_vector_pair : entities_) {
-    for (const auto &entity : entity_type_vector_pair.second) {
-      if (entity->dirty()) {
-        if (auto *subscriber = dynamic_cast<ISubscriber *>(entity.get())) {
-          subscriber->update();
-        }
-      }
-    }
-  }
-}
+void Scene::updateDirtyEntities() { UpdateScheduler::instance().flush(); }
 
 void Scene::processFrame() {
+  PROFILE_SCOPE("Scene::processFrame");
   removeDeadEntities();
   updateDirtyEntities();
+  refreshPickables();
 }
\ No newline at end of file
@@ -1,36 +1,73 @@
 #pragma once
 #include "IEntity.hpp"
 
-#include "camera.hpp"
 #include "entitiesTypes.hpp"
 #include "pointEntity.hpp"
+#include "slotMap.hpp"
 
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
+class Camera;
+
 class Scene {
 public:
+  /// Stays valid until its entity is removed, a stale handle resolves to
+  /// nullptr instead of dangling.
+  struct EntityHandle {
+    EntityType type = EntityType::Point;
+    SlotMap<std::unique_ptr<IEntity>>::Handle slot;
+
+    bool operator==(const EntityHandle &) const = default;
+  };
+
   explicit Scene(Camera *camera) : camera_(camera){};
 
-  std::vector<IEntity *> getEntites() const;
-  void addEntity(EntityType entityType, std::unique_ptr<IEntity> entity);
+  /// every entity in insertion order
+  const std::vector<IEntity *> &getEntites() const { return entities_; }
+  /// bumped whenever an entity is added or removed
+  uint64_t revision() const { return revision_; }
+  EntityHandle addEntity(EntityType entityType,
+                         std::unique_ptr<IEntity> entity);
   Camera *getCamera();
   void removeEntities(std::vector<const IEntity *> &entitiesToRemove);
-  std::unordered_map<EntityType, std::vector<IEntity *>>
-  getGroupedEntities() const;
-  std::vector<IEntity *> getPickables() const;
-  std::vector<IEntity *> getVirtualPoints() const;
-  std::vector<IEntity *> getPoints() const;
+
+  IEntity *getEntity(EntityHandle handle) const;
+  std::optional<EntityHandle> getHandle(const IEntity *entity) const;
+  bool contains(const IEntity *entity) const;
+  /// ids are unique per type only
+  IEntity *findById(EntityType entityType, uint32_t id) const;
+
+  /// contiguous per type views, valid until the scene changes
+  const EntityGroups &getGroupedEntities() const { return groups_; }
+  const std::vector<IEntity *> &getEntities(EntityType entityType) const;
+  /// virtual points then points, as of the last processFrame or removal
+  const std::vector<IEntity *> &getPickables() const { return pickables_; }
+  const std::vector<IEntity *> &getVirtualPoints() const {
+    return virtualPoints_;
+  }
+  const std::vector<IEntity *> &getPoints() const;
 
   void processFrame();
   friend class GUI;
 
 private:
   Camera *camera_;
-  std::unordered_map<EntityType, std::vector<std::unique_ptr<IEntity>>>
-      entities_;
+  std::array<SlotMap<std::unique_ptr<IEntity>>, kEntityTypeCount> storage_;
+  /// groups_[type] mirrors the dense order of storage_[type]
+  EntityGroups groups_;
+  std::vector<IEntity *> entities_;
+  std::unordered_map<const IEntity *, EntityHandle> handles_;
+  std::array<std::unordered_map<uint32_t, IEntity *>, kEntityTypeCount> ids_;
+
+  std::vector<IEntity *> virtualPoints_;
+  std::vector<IEntity *> pickables_;
   std::vector<const IEntity *> deadEntities_;
+  uint64_t revision_ = 0;
 
   void
   enqueueSurfacePoints(std::vector<const IEntity *> &entitiesToRemove) const;
@@ -38,6 +75,8 @@ private:
   IEntity *contractEdge(const PointEntity &p1, const PointEntity &p2);
 
   void rebindReferences(const PointEntity &oldPoint, PointEntity &newPoint);
+  bool removeEntity(const IEntity *entity);
   void removeDeadEntities();
   void updateDirtyEntities();
-};
\ No newline at end of file
+  void refreshPickables();
+};
@@ -1,9 +1,17 @@
 #include "shader.hpp"
+#include "renderStats.hpp"
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
 
-void Shader::use() const { glUseProgram(_id); }
+void Shader::use() const {
+  if (_bound == _id) {
+    return;
+  }
+  glUseProgram(_id);
+  _bound = _id;
+  RenderStats::instance().programBind();
+}
 
 Shader::Shader(const std::vector<ShaderPath> &shaderPaths) {
   std::vector<GLuint> shaderIds;
@@ -29,43 +37,40 @@ Shader::Shader(const std::string &vertexPath, const std::string &geometryPath,
 
 void Shader::setMat4f(const std::string &name,
                       const algebra::Mat4f &mat) const {
-  glUniformMatrix4fv(glGetUniformLocation(_id, name.c_str()), 1, GL_FALSE,
-                     &mat(0, 0));
+  glUniformMatrix4fv(location(name), 1, GL_FALSE, &mat(0, 0));
 }
 
 void Shader::setVec2f(const std::string &name,
                       const algebra::Vec2f &value) const {
-  glUniform2fv(glad_glGetUniformLocation(_id, name.c_str()), 1, &value[0]);
+  glUniform2fv(location(name), 1, &value[0]);
 }
 void Shader::setVec3f(const std::string &name,
                       const algebra::Vec3f &value) const {
-  glUniform3fv(glGetUniformLocation(_id, name.c_str()), 1, &value[0]);
+  glUniform3fv(location(name), 1, &value[0]);
 }
 
 void Shader::setVec4f(const std::string &name,
                       const algebra::Vec4f &value) const {
-  glUniform4fv(glGetUniformLocation(_id, name.c_str()), 1, &value[0]);
-}
-
-void Shader::setViewMatrix(const algebra::Mat4f &view) const {
-  setMat4f("view", view.transpose());
+  glUniform4fv(location(name), 1, &value[0]);
 }
 
 void Shader::setModelMatrix(const algebra::Mat4f &model) const {
   setMat4f("model", model.transpose());
 }
-void Shader::setProjectionMatrix(const algebra::Mat4f &projection) const {
-  setMat4f("projection", projection.transpose());
-}
 
 void Shader::setInt(const std::string &name, int value) const {
-  glUniform1i(glGetUniformLocation(_id, name.c_str()), value);
+  glUniform1i(location(name), value);
 }
 void Shader::setFloat(const std::string &name, float value) const {
-  glUniform1f(glGetUniformLocation(_id, name.c_str()), value);
+  glUniform1f(location(name), value);
 }
 void Shader::setUInt(const std::string &name, uint32_t value) const {
-  glUniform1ui(glGetUniformLocation(_id, name.c_str()), value);
+  glUniform1ui(location(name), value);
+}
+
+GLint Shader::location(const std::string &name) const {
+  RenderStats::instance().uniformUpdate();
+  return glGetUniformLocation(_id, name.c_str());
 }
 
 void Shader::checkCompileErrors(unsigned int shader, const std::string &type) {
@@ -19,6 +19,7 @@ public:
          const std::string &fragmentPath);
 
   void use() const;
+  unsigned int id() const { return _id; }
 
   void setMat4f(const std::string &name, const algebra::Mat4f &mat) const;
   void setVec2f(const std::string &name, const algebra::Vec2f &value) const;
@@ -28,12 +29,16 @@ public:
   void setFloat(const std::string &name, float value) const;
   void setUInt(const std::string &name, uint32_t value) const;
 
-  void setViewMatrix(const algebra::Mat4f &view) const;
+  /// view and projection come from the `Camera` uniform block
   void setModelMatrix(const algebra::Mat4f &model) const;
-  void setProjectionMatrix(const algebra::Mat4f &projection) const;
 
 private:
   unsigned int _id{};
+  /// program last made current, programs are never deleted so ids stay valid
+  static inline unsigned int _bound = 0;
+
+  /// looks up a uniform about to be set, counted as a uniform update
+  GLint location(const std::string &name) const;
   static void checkCompileErrors(unsigned int shader, const std::string &type);
   static std::string readShaderFromFile(const std::string &shaderPath);
   static GLuint createShader(const std::string &shaderSource,
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/// Tracks which square tiles of a texel grid changed since the last take().
+/// Marking is safe from several threads at once.
+class DirtyTiles {
+public:
+  struct Tile {
+    uint32_t x;
+    uint32_t z;
+    uint32_t width;
+    uint32_t height;
+  };
+
+  static constexpr uint32_t kTileSize = 64;
+
+  DirtyTiles(uint32_t width, uint32_t height)
+      : width_(width), height_(height),
+        columns_((width + kTileSize - 1) / kTileSize),
+        rows_((height + kTileSize - 1) / kTileSize),
+        flags_(static_cast<size_t>(columns_) * rows_) {}
+
+  /// texels [columnBegin, columnEnd) of a single row
+  void mark(uint32_t row, uint32_t columnBegin, uint32_t columnEnd) {
+    const uint32_t tile_row = row / kTileSize;
+    for (uint32_t tile = columnBegin / kTileSize;
+         tile <= (columnEnd - 1) / kTileSize; ++tile) {
+      flags_[tile_row * columns_ + tile].store(1, std::memory_order_relaxed);
+    }
+  }
+
+  void markAll() {
+    for (auto &flag : flags_) {
+      flag.store(1, std::memory_order_relaxed);
+    }
+  }
+
+  /// dirty tiles clipped to the grid, flags are cleared
+  std::vector<Tile> take() {
+    std::vector<Tile> tiles;
+    for (uint32_t row = 0; row < rows_; ++row) {
+      for (uint32_t column = 0; column < columns_; ++column) {
+        if (flags_[row * columns_ + column].exchange(
+                0, std::memory_order_relaxed) == 0) {
+          continue;
+        }
+
+        const uint32_t x = column * kTileSize;
+        const uint32_t z = row * kTileSize;
+        tiles.push_back(Tile{.x = x,
+                             .z = z,
+                             .width = std::min(kTileSize, width_ - x),
+                             .height = std::min(kTileSize, height_ - z)});
+      }
+    }
+    return tiles;
+  }
+
+private:
+  uint32_t width_;
+  uint32_t height_;
+  uint32_t columns_;
+  uint32_t rows_;
+  std::vector<std::atomic<uint8_t>> flags_;
+};
@@ -0,0 +1,218 @@
+#include "finishAnalysis.hpp"
+#include "heightMap.hpp"
+#include "nlohmann/json.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+FinishAnalysis::FinishAnalysis(const HeightMap &stock, const HeightMap &design)
+    : stock_(stock), design_(design) {
+  if (stock.divisions().x_ != design.divisions().x_ ||
+      stock.divisions().z_ != design.divisions().z_) {
+    throw std::runtime_error("Stock and design height maps differ in size");
+  }
+}
+
+FinishAnalysis::Summary FinishAnalysis::analyze() {
+  const auto &divisions = stock_.divisions();
+  const std::size_t pixels =
+      static_cast<std::size_t>(divisions.x_) * divisions.z_;
+  residual_.assign(pixels, 0.f);
+  gouge_.assign(pixels, 0.f);
+
+  const uint32_t tiles = (divisions.z_ + kTileRows - 1) / kTileRows;
+  const uint32_t workers_count =
+      std::clamp(std::thread::hardware_concurrency(), 1u, tiles);
+
+  std::vector<Partial> partials(workers_count);
+  std::atomic<uint32_t> next_tile{0};
+
+  std::vector<std::future<void>> workers;
+  workers.reserve(workers_count);
+  for (uint32_t worker = 0; worker < workers_count; ++worker) {
+    workers.push_back(std::async(std::launch::async, [&, worker] {
+      auto &partial = partials[worker];
+      partial.residualCounts.assign(kHistogramBins, 0);
+      partial.gougeCounts.assign(kHistogramBins, 0);
+
+      for (uint32_t tile = next_tile++; tile < tiles; tile = next_tile++) {
+        analyzeTile(tile * kTileRows,
+                    std::min(divisions.z_, (tile + 1) * kTileRows), partial);
+      }
+    }));
+  }
+  for (auto &worker : workers) {
+    worker.get();
+  }
+
+  Partial total;
+  total.residualCounts.assign(kHistogramBins, 0);
+  total.gougeCounts.assign(kHistogramBins, 0);
+  for (const auto &partial : partials) {
+    for (std::size_t bin = 0; bin < kHistogramBins; ++bin) {
+      total.residualCounts[bin] += partial.residualCounts[bin];
+      total.gougeCounts[bin] += partial.gougeCounts[bin];
+    }
+    total.residualSum += partial.residualSum;
+    total.residualSquares += partial.residualSquares;
+    total.gougeSum += partial.gougeSum;
+    total.gougeSquares += partial.gougeSquares;
+    total.residualMax = std::max(total.residualMax, partial.residualMax);
+    total.gougeMax = std::max(total.gougeMax, partial.gougeMax);
+    total.residualOver += partial.residualOver;
+    total.gougeOver += partial.gougeOver;
+  }
+
+  return Summary{
+      .pixels = pixels,
+      .tolerance = tolerance_,
+      .residual = finalize(total.residualSum, total.residualSquares,
+                           total.residualMax, total.residualOver,
+                           std::move(total.residualCounts), pixels),
+      .gouge = finalize(total.gougeSum, total.gougeSquares, total.gougeMax,
+                        total.gougeOver, std::move(total.gougeCounts), pixels),
+  };
+}
+
+/// The difference pass is a plain loop over contiguous floats so it
+/// vectorises; binning runs as a second pass over the same rows.
+void FinishAnalysis::analyzeTile(uint32_t rowBegin, uint32_t rowEnd,
+                                 Partial &partial) {
+  const auto width = stock_.divisions().x_;
+  const std::size_t begin = static_cast<std::size_t>(rowBegin) * width;
+  const std::size_t end = static_cast<std::size_t>(rowEnd) * width;
+
+  const float *stock = stock_.heights().data();
+  const float *design = design_.heights().data();
+  float *residual = residual_.data();
+  float *gouge = gouge_.data();
+
+  for (std::size_t i = begin; i < end; ++i) {
+    const float difference = stock[i] - design[i];
+    residual[i] = std::max(difference, 0.f);
+    gouge[i] = std::max(-difference, 0.f);
+  }
+
+  auto bin = [](float depth) {
+    return std::min(static_cast<std::size_t>(depth / kBinWidth),
+                    kHistogramBins - 1);
+  };
+
+  for (std::size_t i = begin; i < end; ++i) {
+    const float r = residual[i];
+    const float g = gouge[i];
+
+    partial.residualSum += r;
+    partial.residualSquares += static_cast<double>(r) * r;
+    partial.gougeSum += g;
+    partial.gougeSquares += static_cast<double>(g) * g;
+    partial.residualMax = std::max(partial.residualMax, r);
+    partial.gougeMax = std::max(partial.gougeMax, g);
+    partial.residualOver += r > tolerance_ ? 1 : 0;
+    partial.gougeOver += g > tolerance_ ? 1 : 0;
+
+    if (r > 0.f) {
+      partial.residualCounts[bin(r)]++;
+    }
+    if (g > 0.f) {
+      partial.gougeCounts[bin(g)]++;
+    }
+  }
+}
+
+FinishAnalysis::Measure
+FinishAnalysis::finalize(double sum, double squares, float max,
+                         std::size_t over, std::vector<std::size_t> counts,
+                         std::size_t pixels) const {
+  const auto &dimensions = stock_.block().dimensions_;
+  const double pixel_area = static_cast<double>(dimensions.x_) *
+                            dimensions.z_ / static_cast<double>(pixels);
+  const double count = static_cast<double>(std::max<std::size_t>(pixels, 1));
+
+  return Measure{
+      .max = max,
+      .mean = sum / count,
+      .rms = std::sqrt(squares / count),
+      .volume = sum * pixel_area,
+      .pixelsOverTolerance = over,
+      .histogram =
+          Histogram{.binWidth = kBinWidth, .counts = std::move(counts)},
+  };
+}
+
+std::vector<uint8_t> FinishAnalysis::falseColour() const {
+  std::vector<uint8_t> colours(4 * residual_.size());
+
+  auto channel = [](float value) {
+    return static_cast<uint8_t>(std::clamp(value, 0.f, 1.f) * 255.f);
+  };
+
+  for (std::size_t i = 0; i < residual_.size(); ++i) {
+    float red = 0.6f;
+    float green = 0.6f;
+    float blue = 0.6f;
+
+    if (gouge_[i] > tolerance_) {
+      const float t = gouge_[i] / kGougeColourRange;
+      red = 0.6f + 0.4f * t;
+      green = 0.2f * (1.f - t);
+      blue = 0.2f * (1.f - t);
+    } else if (residual_[i] > tolerance_) {
+      const float t = residual_[i] / kResidualColourRange;
+      red = t;
+      green = t;
+      blue = 1.f - t;
+    }
+
+    colours[4 * i] = channel(red);
+    colours[4 * i + 1] = channel(green);
+    colours[4 * i + 2] = channel(blue);
+    colours[4 * i + 3] = 255;
+  }
+  return colours;
+}
+
+nlohmann::json FinishAnalysis::toJson(const Summary &summary) {
+  auto measure = [](const Measure &measure) {
+    return nlohmann::json{
+        {"max", measure.max},
+        {"mean", measure.mean},
+        {"rms", measure.rms},
+        {"volume", measure.volume},
+        {"pixelsOverTolerance", measure.pixelsOverTolerance},
+        {"histogram",
+         {{"binWidth", measure.histogram.binWidth},
+          {"counts", measure.histogram.counts}}},
+    };
+  };
+
+  return nlohmann::json{
+      {"pixels", summary.pixels},
+      {"tolerance", summary.tolerance},
+      {"residual", measure(summary.residual)},
+      {"gouge", measure(summary.gouge)},
+  };
+}
+
+void FinishAnalysis::saveImage(const std::filesystem::path &filename) const {
+  std::ofstream out(filename, std::ios::binary);
+  if (!out) {
+    throw std::runtime_error("Failed to open file: " + filename.string());
+  }
+
+  const auto &divisions = stock_.divisions();
+  out << "P6\n" << divisions.x_ << " " << divisions.z_ << "\n255\n";
+
+  const auto colours = falseColour();
+  for (std::size_t i = 0; i < residual_.size(); ++i) {
+    out.write(reinterpret_cast<const char *>(&colours[4 * i]), 3);
+  }
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "heightMap.hpp"
+#include "nlohmann/json.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+/// Compares simulated stock with the design height map. Residual is the
+/// material left above the design (scallops, uncut regions), gouge the
+/// depth cut below it. Both are kept per pixel in flat arrays; rows are
+/// processed in tiles pulled by worker threads, each worker histograms its
+/// tiles and the histograms are merged afterwards.
+class FinishAnalysis {
+public:
+  struct Histogram {
+    float binWidth = 0.f;
+    /// last bin collects everything deeper than the range
+    std::vector<std::size_t> counts;
+  };
+
+  struct Measure {
+    float max = 0.f;
+    double mean = 0.0;
+    double rms = 0.0;
+    /// [cm^3]
+    double volume = 0.0;
+    std::size_t pixelsOverTolerance = 0;
+    Histogram histogram;
+  };
+
+  struct Summary {
+    std::size_t pixels = 0;
+    float tolerance = 0.f;
+    Measure residual;
+    Measure gouge;
+  };
+
+  FinishAnalysis(const HeightMap &stock, const HeightMap &design);
+
+  float &tolerance() { return tolerance_; }
+
+  Summary analyze();
+
+  const std::vector<float> &residual() const { return residual_; }
+  const std::vector<float> &gouge() const { return gouge_; }
+
+  /// RGBA: grey within tolerance, blue -> yellow residual, red gouge
+  std::vector<uint8_t> falseColour() const;
+
+  static nlohmann::json toJson(const Summary &summary);
+  /// binary PPM, no image library needed
+  void saveImage(const std::filesystem::path &filename) const;
+
+private:
+  static constexpr uint32_t kTileRows = 64;
+  static constexpr std::size_t kHistogramBins = 64;
+  static constexpr float kBinWidth = 0.005f;
+  /// depths mapped to the ends of the colour ramps [cm]
+  static constexpr float kResidualColourRange = 0.2f;
+  static constexpr float kGougeColourRange = 0.05f;
+
+  struct Partial {
+    std::vector<std::size_t> residualCounts;
+    std::vector<std::size_t> gougeCounts;
+    double residualSum = 0.0;
+    double residualSquares = 0.0;
+    double gougeSum = 0.0;
+    double gougeSquares = 0.0;
+    float residualMax = 0.f;
+    float gougeMax = 0.f;
+    std::size_t residualOver = 0;
+    std::size_t gougeOver = 0;
+  };
+
+  const HeightMap &stock_;
+  const HeightMap &design_;
+  float tolerance_ = 0.005f;
+
+  std::vector<float> residual_;
+  std::vector<float> gouge_;
+
+  void analyzeTile(uint32_t rowBegin, uint32_t rowEnd, Partial &partial);
+  Measure finalize(double sum, double squares, float max, std::size_t over,
+                   std::vector<std::size_t> counts,
+                   std::size_t pixels) const;
+};
@@ -0,0 +1,328 @@
+#include "millingSimulator.hpp"
+#include "cutter.hpp"
+#include "heightMap.hpp"
+#include "vec.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+/// restricts [from, to] to x where lo <= coef * x + constant <= hi
+bool restrict(float coef, float constant, float lo, float hi, float &from,
+              float &to) {
+  if (std::abs(coef) < 1e-6f) {
+    return constant >= lo && constant <= hi;
+  }
+
+  float a = (lo - constant) / coef;
+  float b = (hi - constant) / coef;
+  if (a > b) {
+    std::swap(a, b);
+  }
+  from = std::max(from, a);
+  to = std::min(to, b);
+  return from <= to;
+}
+} // namespace
+
+MillingSimulator::MillingSimulator(HeightMap &stock, const HeightMap *design)
+    : stock_(stock), design_(design) {
+  if (design_ && (design_->divisions_.x_ != stock_.divisions_.x_ ||
+                  design_->divisions_.z_ != stock_.divisions_.z_)) {
+    throw std::runtime_error("Stock and design height maps differ in size");
+  }
+}
+
+MillingSimulator::Report
+MillingSimulator::simulate(const std::vector<algebra::Vec3f> &points,
+                           const Cutter &cutter) {
+  Report report;
+  if (points.size() < 2) {
+    return report;
+  }
+  report.moves = points.size() - 1;
+
+  const uint32_t rows = stock_.divisions_.z_;
+  const uint32_t band_count = bandCount();
+
+  std::vector<BandResult> results(band_count);
+  auto run_band = [&](uint32_t index) {
+    const Band band{.begin = rows * index / band_count,
+                    .end = rows * (index + 1) / band_count};
+    results[index].gouging.assign(report.moves, 0);
+    results[index].colliding.assign(report.moves, 0);
+    simulateBand(points, cutter, band, results[index]);
+  };
+
+  if (band_count == 1) {
+    run_band(0);
+  } else {
+    std::vector<std::future<void>> workers;
+    workers.reserve(band_count);
+    for (uint32_t index = 0; index < band_count; ++index) {
+      workers.push_back(std::async(std::launch::async, run_band, index));
+    }
+    for (auto &worker : workers) {
+      worker.get();
+    }
+  }
+
+  for (std::size_t move = 0; move < report.moves; ++move) {
+    const bool gouging = std::ranges::any_of(
+        results, [&](const auto &result) { return result.gouging[move]; });
+    const bool colliding = std::ranges::any_of(
+        results, [&](const auto &result) { return result.colliding[move]; });
+    if (gouging) {
+      report.gougingMoves.push_back(move);
+    }
+    if (colliding) {
+      report.collidingMoves.push_back(move);
+    }
+  }
+
+  return report;
+}
+
+MillingSimulator::GougeStats MillingSimulator::measureGouges() const {
+  GougeStats stats;
+  if (!design_) {
+    return stats;
+  }
+
+  const uint32_t rows = stock_.divisions_.z_;
+  const uint32_t band_count = bandCount();
+
+  std::vector<GougeStats> band_stats(band_count);
+  std::vector<std::future<void>> workers;
+  workers.reserve(band_count);
+  for (uint32_t index = 0; index < band_count; ++index) {
+    const Band band{.begin = rows * index / band_count,
+                    .end = rows * (index + 1) / band_count};
+    workers.push_back(std::async(std::launch::async, [&, band, index] {
+      measureBand(band, band_stats[index]);
+    }));
+  }
+
+  for (auto &worker : workers) {
+    worker.get();
+  }
+  for (const auto &band : band_stats) {
+    stats.gougedPixels += band.gougedPixels;
+    stats.maxGouge = std::max(stats.maxGouge, band.maxGouge);
+  }
+  return stats;
+}
+
+uint32_t MillingSimulator::bandCount() const {
+  return parallel_ ? std::clamp(std::thread::hardware_concurrency(), 1u,
+                                stock_.divisions_.z_)
+                   : 1u;
+}
+
+void MillingSimulator::simulateBand(const std::vector<algebra::Vec3f> &points,
+                                    const Cutter &cutter, Band band,
+                                    BandResult &result) {
+  const auto &divisions = stock_.divisions_;
+  const auto &dimensions = stock_.block().dimensions_;
+  const float radius = cutter.radius();
+
+  const float x_step = dimensions.x_ / static_cast<float>(divisions.x_);
+  const float z_step = dimensions.z_ / static_cast<float>(divisions.z_);
+  const float x_start = -dimensions.x_ / 2.f;
+  const float z_start = -dimensions.z_ / 2.f;
+
+  auto &heights = stock_.data_;
+
+  for (std::size_t move = 0; move + 1 < points.size(); ++move) {
+    const auto &from = points[move];
+    const auto &to = points[move + 1];
+
+    const float z_min = std::min(from.z(), to.z()) - radius;
+    const float z_max = std::max(from.z(), to.z()) + radius;
+    const auto row_begin = std::max(
+        static_cast<int64_t>(band.begin),
+        static_cast<int64_t>(std::ceil((z_min - z_start) / z_step)));
+    const auto row_end = std::min(
+        static_cast<int64_t>(band.end),
+        static_cast<int64_t>(std::floor((z_max - z_start) / z_step)) + 1);
+
+    for (auto row = row_begin; row < row_end; ++row) {
+      const float z = z_start + z_step * static_cast<float>(row);
+
+      float x_min = 0.f;
+      float x_max = 0.f;
+      if (!rowSpan(z, from, to, radius, x_min, x_max)) {
+        continue;
+      }
+
+      const auto column_begin = std::max<int64_t>(
+          0, static_cast<int64_t>(std::ceil((x_min - x_start) / x_step)));
+      const auto column_end = std::min<int64_t>(
+          divisions.x_,
+          static_cast<int64_t>(std::floor((x_max - x_start) / x_step)) + 1);
+
+      auto changed_begin = column_end;
+      auto changed_end = column_begin;
+
+      for (auto column = column_begin; column < column_end; ++column) {
+        const float x = x_start + x_step * static_cast<float>(column);
+
+        Cut cut{};
+        if (!cutAt(x, z, from, to, cutter, cut)) {
+          continue;
+        }
+
+        const auto index =
+            static_cast<std::size_t>(row) * divisions.x_ + column;
+        auto &height = heights[index];
+        if (cut.bottom >= height) {
+          continue;
+        }
+
+        if (height > cut.tip + cutter.height_) {
+          result.colliding[move] = 1;
+        }
+        height = cut.bottom;
+        changed_begin = std::min(changed_begin, column);
+        changed_end = column + 1;
+
+        if (design_ && cut.bottom < design_->data_[index] - gougeTolerance_) {
+          result.gouging[move] = 1;
+        }
+      }
+
+      if (dirtyTiles_ && changed_begin < changed_end) {
+        dirtyTiles_->mark(static_cast<uint32_t>(row),
+                          static_cast<uint32_t>(changed_begin),
+                          static_cast<uint32_t>(changed_end));
+      }
+    }
+  }
+}
+
+void MillingSimulator::measureBand(Band band, GougeStats &stats) const {
+  const auto width = stock_.divisions_.x_;
+  for (std::size_t index = std::size_t{band.begin} * width;
+       index < std::size_t{band.end} * width; ++index) {
+    const float depth = design_->data_[index] - stock_.data_[index];
+    if (depth > gougeTolerance_) {
+      stats.gougedPixels++;
+      stats.maxGouge = std::max(stats.maxGouge, depth);
+    }
+  }
+}
+
+/// Lowest point of the cutter over the vertical line (x, z) while the tip
+/// moves linearly from -> to. With the horizontal distance written as
+/// a(t - t0)^2 + e, a flat end reaches its lowest point at an end of the
+/// feasible interval, a ball at the root of
+/// dy + a(t - t0) / sqrt(R^2 - e - a(t - t0)^2), clamped to that interval.
+bool MillingSimulator::cutAt(float x, float z, const algebra::Vec3f &from,
+                             const algebra::Vec3f &to, const Cutter &cutter,
+                             Cut &cut) {
+  const float radius = cutter.radius();
+  const float r_squared = radius * radius;
+  const bool ball = cutter.type_ == Cutter::Type::Ball;
+
+  const float hx = x - from.x();
+  const float hz = z - from.z();
+  const float dx = to.x() - from.x();
+  const float dy = to.y() - from.y();
+  const float dz = to.z() - from.z();
+
+  const float a = dx * dx + dz * dz;
+  const float b = hx * dx + hz * dz;
+  const float c = hx * hx + hz * hz;
+
+  float t = 0.f;
+  float distance_squared = c;
+
+  if (a < 1e-12f) {
+    if (c > r_squared) {
+      return false;
+    }
+    t = dy < 0.f ? 1.f : 0.f;
+  } else {
+    const float t0 = b / a;
+    const float e = std::max(0.f, c - b * t0);
+    if (e > r_squared) {
+      return false;
+    }
+
+    const float half_width = std::sqrt((r_squared - e) / a);
+    const float lo = std::max(0.f, t0 - half_width);
+    const float hi = std::min(1.f, t0 + half_width);
+    if (lo > hi) {
+      return false;
+    }
+
+    if (ball) {
+      const float u = dy == 0.f ? 0.f
+                                : -dy * std::sqrt(r_squared - e) /
+                                      std::sqrt(a * (a + dy * dy));
+      t = std::clamp(t0 + u, lo, hi);
+    } else {
+      t = dy >= 0.f ? lo : hi;
+    }
+    distance_squared = a * (t - t0) * (t - t0) + e;
+  }
+
+  cut.tip = from.y() + t * dy;
+  cut.bottom = ball ? cut.tip + radius -
+                          std::sqrt(std::max(0.f, r_squared - distance_squared))
+                    : cut.tip;
+  return true;
+}
+
+/// x range of the footprint (capsule of the given radius around the
+/// segment's projection) on row z: hull of both end discs and the band
+/// between them
+bool MillingSimulator::rowSpan(float z, const algebra::Vec3f &from,
+                               const algebra::Vec3f &to, float radius,
+                               float &xMin, float &xMax) {
+  bool found = false;
+  xMin = std::numeric_limits<float>::max();
+  xMax = std::numeric_limits<float>::lowest();
+
+  auto add = [&](float lo, float hi) {
+    found = true;
+    xMin = std::min(xMin, lo);
+    xMax = std::max(xMax, hi);
+  };
+
+  for (const auto *end : {&from, &to}) {
+    const float dz = z - end->z();
+    if (std::abs(dz) <= radius) {
+      const float half = std::sqrt(radius * radius - dz * dz);
+      add(end->x() - half, end->x() + half);
+    }
+  }
+
+  const float dx = to.x() - from.x();
+  const float dz = to.z() - from.z();
+  const float length = std::sqrt(dx * dx + dz * dz);
+  if (length > 0.f) {
+    const float ux = dx / length;
+    const float uz = dz / length;
+
+    float lo = std::numeric_limits<float>::lowest();
+    float hi = std::numeric_limits<float>::max();
+    /// distance across the segment, then position along it
+    if (restrict(-uz, ux * (z - from.z()) + uz * from.x(), -radius, radius,
+                 lo, hi) &&
+        restrict(ux, uz * (z - from.z()) - ux * from.x(), 0.f, length, lo,
+                 hi) &&
+        lo <= hi) {
+      add(lo, hi);
+    }
+  }
+
+  return found;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "cutter.hpp"
+#include "dirtyTiles.hpp"
+#include "heightMap.hpp"
+#include "vec.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Replays tool tip polylines against a stock height field. Every segment is
+/// rasterised as the lower envelope of the cutter swept along it: for each
+/// stock row the span covered by the swept footprint is clipped first, then
+/// the lowest point of the ball (or flat end) over the segment is found in
+/// closed form per pixel. Rows are split into bands simulated concurrently;
+/// each band replays all segments in order, so results do not depend on the
+/// thread count. Needs no GL context.
+class MillingSimulator {
+public:
+  struct GougeStats {
+    std::size_t gougedPixels = 0;
+    float maxGouge = 0.f;
+  };
+
+  struct Report {
+    std::size_t moves = 0;
+    /// indices of segments (point i -> i + 1) cutting below the design
+    std::vector<std::size_t> gougingMoves;
+    /// indices of segments hitting stock above the cutting part
+    std::vector<std::size_t> collidingMoves;
+    /// stock below the design once the job is done
+    GougeStats gouges;
+  };
+
+  /// design may be null, gouges are not checked then
+  MillingSimulator(HeightMap &stock, const HeightMap *design);
+
+  bool &parallel() { return parallel_; }
+  float &gougeTolerance() { return gougeTolerance_; }
+  /// rows touched by later cuts are marked there
+  void setDirtyTiles(DirtyTiles *dirtyTiles) { dirtyTiles_ = dirtyTiles; }
+
+  Report simulate(const std::vector<algebra::Vec3f> &points,
+                  const Cutter &cutter);
+
+  /// stock pixels below the design surface, empty without design
+  GougeStats measureGouges() const;
+
+private:
+  struct Band {
+    uint32_t begin;
+    uint32_t end; // exclusive
+  };
+
+  struct BandResult {
+    std::vector<uint8_t> gouging;
+    std::vector<uint8_t> colliding;
+  };
+
+  struct Cut {
+    float bottom;
+    float tip;
+  };
+
+  HeightMap &stock_;
+  const HeightMap *design_;
+  DirtyTiles *dirtyTiles_ = nullptr;
+  bool parallel_ = true;
+  /// depth [cm] below the design surface still counted as exact
+  float gougeTolerance_ = 0.005f;
+
+  void simulateBand(const std::vector<algebra::Vec3f> &points,
+                    const Cutter &cutter, Band band, BandResult &result);
+  void measureBand(Band band, GougeStats &stats) const;
+  uint32_t bandCount() const;
+
+  static bool cutAt(float x, float z, const algebra::Vec3f &from,
+                    const algebra::Vec3f &to, const Cutter &cutter, Cut &cut);
+  static bool rowSpan(float z, const algebra::Vec3f &from,
+                      const algebra::Vec3f &to, float radius, float &xMin,
+                      float &xMax);
+};
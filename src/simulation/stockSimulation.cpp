@@ -0,0 +1,119 @@
+#include "stockSimulation.hpp"
+#include "heightMap.hpp"
+#include "millingSimulator.hpp"
+#include "vec.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+StockSimulation::StockSimulation(Divisions divisions, const Block *block,
+                                 std::shared_ptr<const HeightMap> design,
+                                 std::vector<Job> jobs)
+    : stock_(divisions, block->dimensions_.y_, block),
+      design_(std::move(design)), dirtyTiles_(divisions.x_, divisions.z_),
+      simulator_(stock_, design_.get()),
+      jobs_(std::move(jobs)) {
+  simulator_.setDirtyTiles(&dirtyTiles_);
+  dirtyTiles_.markAll();
+
+  for (const auto &job : jobs_) {
+    for (std::size_t i = 0; i + 1 < job.points_.size(); ++i) {
+      totalLength_ += (job.points_[i + 1] - job.points_[i]).length();
+    }
+  }
+
+  std::erase_if(jobs_, [](const Job &job) { return job.points_.empty(); });
+  if (!jobs_.empty()) {
+    position_ = jobs_.front().points_.front();
+  }
+}
+
+void StockSimulation::advance(float seconds) {
+  if (playing_ && !finished()) {
+    step(speed_ * seconds);
+  }
+}
+
+void StockSimulation::finish() {
+  step(std::numeric_limits<float>::infinity());
+}
+
+float StockSimulation::progress() const {
+  if (finished()) {
+    return 1.f;
+  }
+  return totalLength_ > 0.f ? std::min(travelled_ / totalLength_, 1.f) : 0.f;
+}
+
+void StockSimulation::step(float distance) {
+  std::vector<algebra::Vec3f> chunk{position_};
+  std::size_t first_move = point_;
+
+  while (distance > 0.f && !finished()) {
+    const auto &points = jobs_[job_].points_;
+    if (point_ + 1 >= points.size()) {
+      cut(chunk, first_move);
+      finishJob();
+
+      if (finished()) {
+        return;
+      }
+      position_ = jobs_[job_].points_.front();
+      chunk = {position_};
+      first_move = 0;
+      continue;
+    }
+
+    const auto &target = points[point_ + 1];
+    const float remaining = (target - position_).length();
+    if (remaining <= distance) {
+      distance -= remaining;
+      travelled_ += remaining;
+      position_ = target;
+      ++point_;
+    } else {
+      position_ = position_ + (target - position_) * (distance / remaining);
+      travelled_ += distance;
+      distance = 0.f;
+    }
+    chunk.push_back(position_);
+  }
+
+  cut(chunk, first_move);
+}
+
+/// chunk[0] lies on move firstMove, so chunk move m is path move
+/// firstMove + m
+void StockSimulation::cut(const std::vector<algebra::Vec3f> &chunk,
+                          std::size_t firstMove) {
+  if (chunk.size() < 2) {
+    return;
+  }
+
+  const auto report = simulator_.simulate(chunk, jobs_[job_].cutter_);
+
+  auto merge = [firstMove](const std::vector<std::size_t> &moves,
+                           std::vector<std::size_t> &into) {
+    for (const auto move : moves) {
+      if (into.empty() || into.back() < firstMove + move) {
+        into.push_back(firstMove + move);
+      }
+    }
+  };
+  merge(report.gougingMoves, current_.gougingMoves);
+  merge(report.collidingMoves, current_.collidingMoves);
+}
+
+void StockSimulation::finishJob() {
+  current_.moves = jobs_[job_].points_.size() - 1;
+  current_.gouges = simulator_.measureGouges();
+
+  reports_.push_back(std::move(current_));
+  current_ = {};
+  ++job_;
+  point_ = 0;
+}
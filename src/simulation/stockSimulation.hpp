@@ -0,0 +1,71 @@
+#pragma once
+
+#include "block.hpp"
+#include "cutter.hpp"
+#include "dirtyTiles.hpp"
+#include "heightMap.hpp"
+#include "millingSimulator.hpp"
+#include "vec.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// Plays milling jobs back on a stock height map at a feed given in cm per
+/// second of wall time, so the pace does not depend on the frame rate.
+/// Every advance cuts the path travelled since the previous one, including
+/// a partial segment, and marks the touched stock tiles dirty.
+class StockSimulation {
+public:
+  struct Job {
+    std::string name_;
+    std::vector<algebra::Vec3f> points_;
+    Cutter cutter_;
+  };
+
+  StockSimulation(Divisions divisions, const Block *block,
+                  std::shared_ptr<const HeightMap> design,
+                  std::vector<Job> jobs);
+
+  void advance(float seconds);
+  /// cuts everything left at once
+  void finish();
+  bool finished() const { return job_ >= jobs_.size(); }
+
+  bool &playing() { return playing_; }
+  float &speed() { return speed_; }
+  float progress() const;
+
+  const HeightMap &stock() const { return stock_; }
+  DirtyTiles &dirtyTiles() { return dirtyTiles_; }
+  const algebra::Vec3f &cutterPosition() const { return position_; }
+
+  /// one per finished job
+  const std::vector<MillingSimulator::Report> &reports() const {
+    return reports_;
+  }
+  const std::vector<Job> &jobs() const { return jobs_; }
+
+private:
+  HeightMap stock_;
+  std::shared_ptr<const HeightMap> design_;
+  DirtyTiles dirtyTiles_;
+  MillingSimulator simulator_;
+
+  std::vector<Job> jobs_;
+  std::size_t job_ = 0;
+  std::size_t point_ = 0;
+  algebra::Vec3f position_;
+
+  MillingSimulator::Report current_;
+  std::vector<MillingSimulator::Report> reports_;
+
+  bool playing_ = true;
+  float speed_ = 5.f;
+  float totalLength_ = 0.f;
+  float travelled_ = 0.f;
+
+  void step(float distance);
+  void cut(const std::vector<algebra::Vec3f> &chunk, std::size_t firstMove);
+  void finishJob();
+};
@@ -55,6 +55,7 @@ uint32_t IntersectionTexture::getTextureId() const {
 
 void IntersectionTexture::drawLine(
     const std::vector<algebra::Vec2f> &surfacePoints, Color color) {
+  ++revision_;
 
   const algebra::Vec2f u_bounds = bounds_[0];
   const algebra::Vec2f v_bounds = bounds_[1];
@@ -143,6 +144,7 @@ void IntersectionTexture::fillCanvas(
 }
 
 void IntersectionTexture::floodFill(uint32_t x, uint32_t y, bool transparent) {
+  ++revision_;
 
   std::vector<std::vector<bool>> visited(kHeight,
                                          std::vector<bool>(kWidth, false));
@@ -221,10 +223,12 @@ void IntersectionTexture::setCellType(uint32_t x, uint32_t y,
   };
 
   canvas_.fillAtIndex(y * kWidth + x, color);
+  ++revision_;
 }
 
 void IntersectionTexture::setColor(uint32_t x, uint32_t y, Color color) {
   canvas_.fillAtIndex(y * kWidth + x, color);
+  ++revision_;
 }
 
 IntersectionTexture::CellType
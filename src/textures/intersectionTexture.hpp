@@ -1,8 +1,10 @@
 #pragma once
 #include "canvas.hpp"
 #include "color.hpp"
+#include "intersectionFinder.hpp"
 #include "texture.hpp"
 #include "vec.hpp"
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <print>
@@ -45,8 +47,14 @@ public:
   void setWrapping(bool wrapU, bool wrapV) {
     wrapU_ = wrapU;
     wrapV_ = wrapV;
+    ++revision_;
   }
 
+  /// unique per texture, together with revision() identifies the contents
+  uint64_t id() const { return id_; }
+  /// changes with every edit of the cells
+  uint64_t revision() const { return revision_; }
+
   algebra::Vec2f uv(uint32_t x, uint32_t y) const;
   static Coord uvToCoord(const algebra::Vec2f &uv);
 
@@ -64,6 +72,7 @@ public:
   std::vector<Segment> &getIntersectionCurve() { return intersectionCurve_; }
   void setIntersectionCurve(const std::vector<Segment> &intersectionCurve) {
     intersectionCurve_ = intersectionCurve;
+    ++revision_;
   }
 
   void closeIntersectionCurve();
@@ -74,6 +83,9 @@ public:
 private:
   static int constexpr kWidth = 1500;
   static int constexpr kHeight = 1500;
+  static inline std::atomic<uint64_t> nextId_ = 0;
+  uint64_t id_ = nextId_++;
+  uint64_t revision_ = 0;
   bool wrapU_ = false;
   bool wrapV_ = false;
   std::unique_ptr<Texture> texture_;
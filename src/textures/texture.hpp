@@ -1,5 +1,4 @@
 #pragma once
-#include "intersectionFinder.hpp"
 #include "textureResource.hpp"
 #include <cstdint>
 #include <memory>
@@ -37,6 +36,7 @@ public:
 
   void bind(uint32_t unit) const {
     _textureResource.bind(unit);
+#ifndef ARMCADILLO_HEADLESS
     if (_filtering == TextureFiltering::Linear) {
       glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
       glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -60,6 +60,7 @@ public:
       glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_MIRRORED_REPEAT);
       glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_MIRRORED_REPEAT);
     }
+#endif
   }
 
   uint32_t getTextureId() const { return _textureResource.getTextureId(); }
@@ -1,52 +1,66 @@
 #pragma once
+#ifndef ARMCADILLO_HEADLESS
 #include <glad/gl.h>
 
 #include "GLFW/glfw3.h"
+#endif
 #include "image.hpp"
+#include <cstdint>
 #include <memory>
 
+/// ARMCADILLO_HEADLESS builds keep the bookkeeping without a GL context,
+/// every texture id stays 0
 class TextureResource {
 public:
   TextureResource(const uint32_t width, const uint32_t height)
       : _width(width), _height(height) {
+#ifndef ARMCADILLO_HEADLESS
     glGenTextures(1, &_id);
     setWrappingParameters();
+#endif
   };
   TextureResource(const Image &image)
       : _width(image.getWidth()), _height(image.getHeight()), bpp(4) {
-
+#ifndef ARMCADILLO_HEADLESS
     glGenTextures(1, &_id);
     glBindTexture(GL_TEXTURE_2D, _id);
     setWrappingParameters();
 
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, _width, _height, 0, GL_RGBA,
                  GL_UNSIGNED_INT_8_8_8_8, image.raw());
+#endif
   }
 
   void bind(uint32_t unit) const {
+#ifndef ARMCADILLO_HEADLESS
     glActiveTexture(GL_TEXTURE0 + unit);
     glBindTexture(GL_TEXTURE_2D, _id);
     setWrappingParameters();
+#endif
   }
 
   void fill(const std::vector<uint8_t> &canvas) {
+#ifndef ARMCADILLO_HEADLESS
     glBindTexture(GL_TEXTURE_2D, _id);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, _width, _height, 0, GL_RGBA,
                  GL_UNSIGNED_BYTE, canvas.data());
     setWrappingParameters();
+#endif
   }
 
-  GLuint getTextureId() const { return _id; }
+  uint32_t getTextureId() const { return _id; }
 
 private:
-  GLuint _id{};
+  uint32_t _id{};
   int _width, _height, bpp;
 
   void setWrappingParameters() const {
+#ifndef ARMCADILLO_HEADLESS
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     // set texture filtering parameters
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+#endif
   }
 };
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include "autosave.hpp"
+#include "binaryScene.hpp"
+#include "profiler.hpp"
+#include "sceneHistory.hpp"
+#include <exception>
+#include <mutex>
+#include <print>
+#include <string>
+#include <utility>
+
+Autosave::Autosave(std::filesystem::path path, std::chrono::seconds interval)
+    : path_(std::move(path)), interval_(interval), worker_([this] {
+        Profiler::instance().setThreadName("autosave");
+        run();
+      }) {}
+
+Autosave::~Autosave() {
+  {
+    std::scoped_lock lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  worker_.join();
+}
+
+void Autosave::submit(std::shared_ptr<const SceneSnapshot> snapshot) {
+  std::scoped_lock lock(mutex_);
+  pending_ = std::move(snapshot);
+}
+
+std::filesystem::path Autosave::defaultPath() {
+  return std::filesystem::temp_directory_path() /
+         ("armCADillo-autosave" + std::string(BinaryScene::kExtension));
+}
+
+void Autosave::run() {
+  std::unique_lock lock(mutex_);
+  while (true) {
+    const bool stopping =
+        wake_.wait_for(lock, interval_, [this] { return stopping_; });
+
+    auto snapshot = std::exchange(pending_, nullptr);
+    if (snapshot) {
+      lock.unlock();
+      write(*snapshot);
+      lock.lock();
+    }
+    if (stopping) {
+      return;
+    }
+  }
+}
+
+void Autosave::write(const SceneSnapshot &snapshot) const {
+  try {
+    snapshot.save(path_.string());
+  } catch (const std::exception &e) {
+    std::println(stderr, "autosave: {}", e.what());
+  }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+class SceneSnapshot;
+
+/// Writes the newest submitted snapshot to disk on its own thread, at most
+/// once per interval, so saving never stalls a frame. Snapshots are
+/// immutable, the thread needs no access to the scene.
+class Autosave {
+public:
+  static constexpr std::chrono::seconds kDefaultInterval{30};
+
+  explicit Autosave(std::filesystem::path path,
+                    std::chrono::seconds interval = kDefaultInterval);
+  /// writes a snapshot still pending, then joins the thread
+  ~Autosave();
+
+  Autosave(const Autosave &) = delete;
+  Autosave &operator=(const Autosave &) = delete;
+
+  /// replaces a snapshot that was not written yet
+  void submit(std::shared_ptr<const SceneSnapshot> snapshot);
+  const std::filesystem::path &path() const { return path_; }
+
+  /// binary scene in the temporary directory
+  static std::filesystem::path defaultPath();
+
+private:
+  std::filesystem::path path_;
+  std::chrono::seconds interval_;
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::shared_ptr<const SceneSnapshot> pending_;
+  bool stopping_ = false;
+  std::thread worker_;
+
+  void run();
+  void write(const SceneSnapshot &snapshot) const;
+};
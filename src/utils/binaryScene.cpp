@@ -0,0 +1,379 @@
+#include "binaryScene.hpp"
+#include "IEntity.hpp"
+#include "IGroupedEntity.hpp"
+#include "bSplineCurve.hpp"
+#include "bezierCurveC0.hpp"
+#include "bezierSurface.hpp"
+#include "bezierSurfaceC0.hpp"
+#include "bezierSurfaceC2.hpp"
+#include "entitiesTypes.hpp"
+#include "interpolatingSplineC2.hpp"
+#include "pointEntity.hpp"
+#include "profiler.hpp"
+#include "scene.hpp"
+#include "torusEntity.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Kind = BinaryScene::Kind;
+
+template <typename T>
+void appendBytes(std::vector<std::byte> &buffer, std::span<const T> values) {
+  const auto bytes = std::as_bytes(values);
+  buffer.insert(buffer.end(), bytes.begin(), bytes.end());
+}
+
+algebra::Vec3f toVec(const std::array<float, 3> &values) {
+  return {values[0], values[1], values[2]};
+}
+
+std::array<float, 3> toArray(const algebra::Vec3f &vec) {
+  return {vec[0], vec[1], vec[2]};
+}
+
+/// control points a surface of this kind and patch count is built from
+uint64_t surfacePointCount(Kind kind, const std::array<uint32_t, 2> &patches) {
+  const uint64_t u = patches[0];
+  const uint64_t v = patches[1];
+  return kind == Kind::BezierSurfaceC0 ? (3 * u + 1) * (3 * v + 1)
+                                       : (u + 3) * (v + 3);
+}
+
+} // namespace
+
+BinaryScene::BinaryScene(const std::string &path) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Cannot open scene file " + path);
+  }
+
+  struct stat status {};
+  if (::fstat(fd, &status) != 0 ||
+      static_cast<size_t>(status.st_size) < sizeof(Header)) {
+    ::close(fd);
+    throw std::runtime_error(path + " is not a binary scene");
+  }
+
+  size_ = static_cast<size_t>(status.st_size);
+  void *mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    throw std::runtime_error("Cannot map scene file " + path);
+  }
+  data_ = static_cast<const std::byte *>(mapping);
+
+  try {
+    validate();
+  } catch (...) {
+    ::munmap(const_cast<std::byte *>(data_), size_);
+    throw;
+  }
+}
+
+BinaryScene::~BinaryScene() {
+  ::munmap(const_cast<std::byte *>(data_), size_);
+}
+
+bool BinaryScene::matches(const std::string &path) {
+  std::ifstream file(path, std::ios::binary);
+  std::array<char, 4> magic{};
+  return file.read(magic.data(), magic.size()) && magic == kMagic;
+}
+
+std::string_view BinaryScene::name(const NameRef &ref) const {
+  return names_.substr(ref.offset, ref.length);
+}
+
+void BinaryScene::validate() {
+  header_ = reinterpret_cast<const Header *>(data_);
+  if (header_->magic != kMagic) {
+    throw std::runtime_error("Not a binary scene");
+  }
+  if (header_->version != kVersion) {
+    throw std::runtime_error("Unsupported binary scene version " +
+                             std::to_string(header_->version));
+  }
+
+  const uint64_t points_bytes =
+      uint64_t{header_->pointCount} * sizeof(PointRecord);
+  const uint64_t entities_bytes =
+      uint64_t{header_->entityCount} * sizeof(EntityRecord);
+  const uint64_t indices_bytes = uint64_t{header_->indexCount} * 4;
+  if (sizeof(Header) + points_bytes + entities_bytes + indices_bytes +
+          header_->nameBytes !=
+      size_) {
+    throw std::runtime_error("Binary scene size does not match its header");
+  }
+
+  const auto *cursor = data_ + sizeof(Header);
+  points_ = {reinterpret_cast<const PointRecord *>(cursor),
+             header_->pointCount};
+  cursor += points_bytes;
+  entities_ = {reinterpret_cast<const EntityRecord *>(cursor),
+               header_->entityCount};
+  cursor += entities_bytes;
+  indices_ = {reinterpret_cast<const uint32_t *>(cursor), header_->indexCount};
+  cursor += indices_bytes;
+  names_ = {reinterpret_cast<const char *>(cursor), header_->nameBytes};
+
+  /// checked once here so load() can index without bounds checks
+  const auto name_fits = [this](const NameRef &ref) {
+    return uint64_t{ref.offset} + ref.length <= names_.size();
+  };
+  if (!std::ranges::all_of(points_, [&](const PointRecord &point) {
+        return name_fits(point.name);
+      })) {
+    throw std::runtime_error("Binary scene point name out of range");
+  }
+  if (!std::ranges::all_of(indices_, [this](uint32_t index) {
+        return index < points_.size();
+      })) {
+    throw std::runtime_error("Binary scene control point out of range");
+  }
+  for (const auto &entity : entities_) {
+    if (entity.kind > Kind::BezierSurfaceC2 || !name_fits(entity.name) ||
+        uint64_t{entity.firstIndex} + entity.indexCount > indices_.size()) {
+      throw std::runtime_error("Corrupted binary scene entity " +
+                               std::to_string(entity.id));
+    }
+    const bool surface = entity.kind == Kind::BezierSurfaceC0 ||
+                         entity.kind == Kind::BezierSurfaceC2;
+    if (surface &&
+        (entity.patches[0] == 0 || entity.patches[1] == 0 ||
+         surfacePointCount(entity.kind, entity.patches) != entity.indexCount ||
+         entity.connection > static_cast<uint32_t>(
+                                 algebra::ConnectionType::Flat))) {
+      throw std::runtime_error("Corrupted binary scene surface " +
+                               std::to_string(entity.id));
+    }
+  }
+}
+
+BinaryScene::Contents BinaryScene::capture(const Scene &scene) {
+  Contents contents;
+  auto &[points, entities, indices, names] = contents;
+
+  const auto add_name = [&names](const std::string &name) {
+    const NameRef ref{static_cast<uint32_t>(names.size()),
+                      static_cast<uint32_t>(name.size())};
+    names += name;
+    return ref;
+  };
+
+  const auto &scene_points = scene.getEntities(EntityType::Point);
+  std::unordered_map<const IEntity *, uint32_t> point_indices;
+  point_indices.reserve(scene_points.size());
+  points.reserve(scene_points.size());
+  for (const auto *point : scene_points) {
+    point_indices.emplace(point, static_cast<uint32_t>(points.size()));
+    points.push_back({.id = point->getId(),
+                      .position = toArray(point->getPosition()),
+                      .name = add_name(point->getName())});
+  }
+
+  const auto add_entity = [&](Kind kind, IEntity &entity) -> EntityRecord & {
+    const auto &rotation = entity.getRotation();
+    auto &record = entities.emplace_back();
+    record.kind = kind;
+    record.id = entity.getId();
+    record.name = add_name(entity.getName());
+    record.position = toArray(entity.getPosition());
+    record.rotation = {rotation.x(), rotation.y(), rotation.z(), rotation.w()};
+    record.scale = toArray(entity.getScale());
+    return record;
+  };
+  const auto add_points = [&](EntityRecord &record,
+                              const IGroupedEntity &grouped) {
+    record.firstIndex = static_cast<uint32_t>(indices.size());
+    for (const auto &point : grouped.getPointsReferences()) {
+      const auto it = point_indices.find(&point.get());
+      if (it == point_indices.end()) {
+        throw std::runtime_error(grouped.getName() +
+                                 " uses a point missing from the scene");
+      }
+      indices.push_back(it->second);
+    }
+    record.indexCount =
+        static_cast<uint32_t>(indices.size()) - record.firstIndex;
+  };
+
+  for (auto *entity : scene.getEntities(EntityType::Torus)) {
+    auto &torus = static_cast<TorusEntity &>(*entity);
+    auto &record = add_entity(Kind::Torus, torus);
+    record.samples = {torus.getMeshDensity().s, torus.getMeshDensity().t};
+    record.radii = {torus.getInnerRadius(), torus.getTubeRadius()};
+  }
+
+  const std::array<std::pair<EntityType, Kind>, 3> curves{
+      {{EntityType::BezierCurveC0, Kind::BezierCurveC0},
+       {EntityType::BSplineCurve, Kind::BSplineCurve},
+       {EntityType::InterpolatingSplineCurve, Kind::InterpolatingSpline}}};
+  for (const auto &[type, kind] : curves) {
+    for (auto *entity : scene.getEntities(type)) {
+      auto &curve = static_cast<IGroupedEntity &>(*entity);
+      add_points(add_entity(kind, curve), curve);
+    }
+  }
+
+  const std::array<std::pair<EntityType, Kind>, 2> surfaces{
+      {{EntityType::BezierSurfaceC0, Kind::BezierSurfaceC0},
+       {EntityType::BezierSurfaceC2, Kind::BezierSurfaceC2}}};
+  for (const auto &[type, kind] : surfaces) {
+    for (auto *entity : scene.getEntities(type)) {
+      auto &surface = static_cast<BezierSurface &>(*entity);
+      auto &record = add_entity(kind, surface);
+      add_points(record, surface);
+      record.patches = {surface.getPatches().colCount,
+                        surface.getPatches().rowCount};
+      record.samples = {surface.getMeshDensity().s,
+                        surface.getMeshDensity().t};
+      record.connection =
+          static_cast<uint32_t>(surface.getConnectionType());
+    }
+  }
+
+  return contents;
+}
+
+void BinaryScene::save(const Scene &scene, const std::string &path) {
+  PROFILE_SCOPE("BinaryScene::save");
+  const auto contents = capture(scene);
+
+  Header header;
+  header.pointCount = static_cast<uint32_t>(contents.points.size());
+  header.entityCount = static_cast<uint32_t>(contents.entities.size());
+  header.indexCount = static_cast<uint32_t>(contents.indices.size());
+  header.nameBytes = static_cast<uint32_t>(contents.names.size());
+
+  std::vector<std::byte> buffer;
+  buffer.reserve(sizeof(Header) +
+                 contents.points.size() * sizeof(PointRecord) +
+                 contents.entities.size() * sizeof(EntityRecord) +
+                 contents.indices.size() * sizeof(uint32_t) +
+                 contents.names.size());
+  appendBytes(buffer, std::span<const Header>(&header, 1));
+  appendBytes(buffer, std::span<const PointRecord>(contents.points));
+  appendBytes(buffer, std::span<const EntityRecord>(contents.entities));
+  appendBytes(buffer, std::span<const uint32_t>(contents.indices));
+  appendBytes(buffer, std::span<const char>(contents.names));
+  writeFile(path, buffer);
+}
+
+void BinaryScene::writeFile(const std::string &path,
+                            std::span<const std::byte> bytes) {
+  const std::string temporary = path + ".tmp";
+  {
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    if (!file.write(reinterpret_cast<const char *>(bytes.data()),
+                    static_cast<std::streamsize>(bytes.size()))) {
+      throw std::runtime_error("Unable to write file: " + path);
+    }
+  }
+  std::filesystem::rename(temporary, path);
+}
+
+void BinaryScene::load(Scene &scene) const {
+  PROFILE_SCOPE("BinaryScene::load");
+  std::vector<std::reference_wrapper<PointEntity>> points;
+  points.reserve(points_.size());
+  for (const auto &record : points_) {
+    auto point = std::make_unique<PointEntity>(toVec(record.position));
+    point->setId(record.id);
+    point->getName() = name(record.name);
+    points.emplace_back(*point);
+    scene.addEntity(EntityType::Point, std::move(point));
+  }
+
+  std::vector<std::reference_wrapper<PointEntity>> control_points;
+  for (const auto &record : entities_) {
+    control_points.clear();
+    for (const auto index :
+         indices_.subspan(record.firstIndex, record.indexCount)) {
+      control_points.push_back(points[index]);
+    }
+
+    scene.addEntity(entityType(record.kind),
+                    makeEntity(record, name(record.name), control_points));
+  }
+}
+
+EntityType BinaryScene::entityType(Kind kind) {
+  switch (kind) {
+  case Kind::Torus:
+    return EntityType::Torus;
+  case Kind::BezierCurveC0:
+    return EntityType::BezierCurveC0;
+  case Kind::BSplineCurve:
+    return EntityType::BSplineCurve;
+  case Kind::InterpolatingSpline:
+    return EntityType::InterpolatingSplineCurve;
+  case Kind::BezierSurfaceC0:
+    return EntityType::BezierSurfaceC0;
+  case Kind::BezierSurfaceC2:
+    return EntityType::BezierSurfaceC2;
+  }
+  throw std::runtime_error("Unknown binary scene entity kind");
+}
+
+std::unique_ptr<IEntity> BinaryScene::makeEntity(
+    const EntityRecord &record, std::string_view name,
+    const std::vector<std::reference_wrapper<PointEntity>> &points) {
+  const auto connection =
+      static_cast<algebra::ConnectionType>(record.connection);
+  const MeshDensity samples{.s = record.samples[0], .t = record.samples[1]};
+  std::unique_ptr<IEntity> entity;
+  switch (record.kind) {
+  case Kind::Torus: {
+    auto torus = std::make_unique<TorusEntity>(
+        record.radii[0], record.radii[1], toVec(record.position), samples);
+    const auto &r = record.rotation;
+    torus->getRotation() =
+        algebra::Quaternion<float>(r[3], r[0], r[1], r[2]).normalized();
+    torus->getScale() = toVec(record.scale);
+    entity = std::move(torus);
+    break;
+  }
+  case Kind::BezierCurveC0:
+    entity = std::make_unique<BezierCurveC0>(points);
+    break;
+  case Kind::BSplineCurve:
+    entity = std::make_unique<BSplineCurve>(points);
+    break;
+  case Kind::InterpolatingSpline:
+    entity = std::make_unique<InterpolatingSplineC2>(points);
+    break;
+  case Kind::BezierSurfaceC0: {
+    auto surface = std::make_unique<BezierSurfaceC0>(
+        points, record.patches[0], record.patches[1], connection);
+    surface->getMeshDensity() = samples;
+    entity = std::move(surface);
+    break;
+  }
+  case Kind::BezierSurfaceC2: {
+    auto surface = std::make_unique<BezierSurfaceC2>(
+        points, record.patches[0], record.patches[1], connection);
+    surface->getMeshDensity() = samples;
+    entity = std::move(surface);
+    break;
+  }
+  }
+
+  entity->getName() = name;
+  entity->getId() = record.id;
+  return entity;
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "entitiesTypes.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class IEntity;
+class PointEntity;
+class Scene;
+
+/// Compact scene file: a versioned header followed by flat arrays of fixed
+/// size records, read in place from a mapping of the file. Geometry refers to
+/// control points by their position in the point array. JSON stays the
+/// interchange format, both load into and save from a Scene, which is how
+/// one is converted into the other.
+class BinaryScene {
+public:
+  static constexpr std::array<char, 4> kMagic{'A', 'C', 'S', 'C'};
+  static constexpr uint32_t kVersion = 1;
+  static constexpr std::string_view kExtension = ".acsc";
+
+  struct NameRef {
+    uint32_t offset = 0;
+    uint32_t length = 0;
+  };
+
+  struct Header {
+    std::array<char, 4> magic = kMagic;
+    uint32_t version = kVersion;
+    uint32_t pointCount = 0;
+    uint32_t entityCount = 0;
+    uint32_t indexCount = 0;
+    uint32_t nameBytes = 0;
+  };
+
+  struct PointRecord {
+    uint32_t id = 0;
+    std::array<float, 3> position{};
+    NameRef name;
+  };
+
+  /// stable on disk, unlike EntityType
+  enum class Kind : uint32_t {
+    Torus,
+    BezierCurveC0,
+    BSplineCurve,
+    InterpolatingSpline,
+    BezierSurfaceC0,
+    BezierSurfaceC2
+  };
+
+  /// one record for every kind, fields a kind does not use stay zero
+  struct EntityRecord {
+    Kind kind = Kind::Torus;
+    uint32_t id = 0;
+    NameRef name;
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+    /// surface patches along u and v
+    std::array<uint32_t, 2> patches{};
+    std::array<int32_t, 2> samples{};
+    uint32_t connection = 0;
+    std::array<float, 3> position{};
+    std::array<float, 4> rotation{};
+    std::array<float, 3> scale{};
+    /// torus inner and tube radius
+    std::array<float, 2> radii{};
+  };
+
+  /// maps the file, throws when it is not a scene of this version
+  explicit BinaryScene(const std::string &path);
+  ~BinaryScene();
+
+  BinaryScene(const BinaryScene &) = delete;
+  BinaryScene &operator=(const BinaryScene &) = delete;
+
+  /// true when the file starts with the binary scene magic
+  static bool matches(const std::string &path);
+
+  /// the sections of a file before they are laid out one after another
+  struct Contents {
+    std::vector<PointRecord> points;
+    std::vector<EntityRecord> entities;
+    std::vector<uint32_t> indices;
+    std::string names;
+  };
+
+  static Contents capture(const Scene &scene);
+  /// writes the scene with a single write of one buffer
+  static void save(const Scene &scene, const std::string &path);
+  /// writes through a temporary file, so a failed write keeps the old file
+  static void writeFile(const std::string &path,
+                        std::span<const std::byte> bytes);
+  /// adds the stored entities to the scene
+  void load(Scene &scene) const;
+
+  /// the scene type entities of this kind are stored under
+  static EntityType entityType(Kind kind);
+  /// builds the entity a record describes on its control points, already
+  /// resolved from the record's indices
+  static std::unique_ptr<IEntity>
+  makeEntity(const EntityRecord &record, std::string_view name,
+             const std::vector<std::reference_wrapper<PointEntity>> &points);
+
+  const Header &header() const { return *header_; }
+  std::span<const PointRecord> points() const { return points_; }
+  std::span<const EntityRecord> entities() const { return entities_; }
+  std::span<const uint32_t> indices() const { return indices_; }
+  std::string_view name(const NameRef &ref) const;
+
+private:
+  const std::byte *data_ = nullptr;
+  size_t size_ = 0;
+
+  const Header *header_ = nullptr;
+  std::span<const PointRecord> points_;
+  std::span<const EntityRecord> entities_;
+  std::span<const uint32_t> indices_;
+  std::string_view names_;
+
+  /// points the sections into the mapping and checks every reference
+  void validate();
+};
+
+/// records are read straight from the mapping, so they must stay plain and
+/// 4 byte aligned
+static_assert(std::is_trivially_copyable_v<BinaryScene::Header>);
+static_assert(std::is_trivially_copyable_v<BinaryScene::PointRecord>);
+static_assert(std::is_trivially_copyable_v<BinaryScene::EntityRecord>);
+static_assert(sizeof(BinaryScene::Header) % 4 == 0);
+static_assert(sizeof(BinaryScene::PointRecord) % 4 == 0);
+static_assert(sizeof(BinaryScene::EntityRecord) % 4 == 0);
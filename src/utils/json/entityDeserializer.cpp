@@ -1,9 +1,11 @@
 #include "entityDeserializer.hpp"
+#include "entitiesTypes.hpp"
 #include "nlohmann/json.hpp"
 #include "pointEntity.hpp"
 #include "scene.hpp"
 #include "surface.hpp"
 #include "vec.hpp"
+#include <cstdint>
 #include <functional>
 
 using json = nlohmann::json;
@@ -39,16 +41,13 @@ EntityDeserializer::deserializeRotation(const json &j) const {
 std::vector<std::reference_wrapper<PointEntity>>
 EntityDeserializer::getPoints(const json &j, const Scene &scene) const {
   const auto &control_points_json = j.at("controlPoints");
-  const auto &points = scene.getPoints();
   std::vector<std::reference_wrapper<PointEntity>> points_references;
+  points_references.reserve(control_points_json.size());
 
   for (const auto &point : control_points_json) {
-    const auto &id = point.at("id");
-    const auto iter = std::ranges::find_if(
-        points, [id](const auto &p) { return p->getId() == id; });
-
-    if (iter != points.end()) {
-      auto *entity = dynamic_cast<PointEntity *>(*iter);
+    const auto id = point.at("id").get<uint32_t>();
+    if (auto *entity = dynamic_cast<PointEntity *>(
+            scene.findById(EntityType::Point, id))) {
       points_references.emplace_back(*entity);
     }
   }
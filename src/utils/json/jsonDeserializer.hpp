@@ -11,7 +11,10 @@
 #include "scene.hpp"
 #include "torusDeserializer.hpp"
 #include <fstream>
+#include <iterator>
 #include <memory>
+#include <stdexcept>
+#include <string>
 #include <unordered_map>
 
 class JsonDeserializer {
@@ -24,13 +27,13 @@ public:
   }
 
   void loadScence(const std::string &path, Scene &scene) const {
-    auto json = readJson(path);
-    auto geometry_json = json.at("geometry");
-    auto point_json = json.at("points");
+    const auto json = readJson(path);
+    const auto &geometry_json = json.at("geometry");
+    const auto &point_json = json.at("points");
 
+    const auto &point_deserializer = _deserializerMap.at(EntityType::Point);
     for (const auto &json : point_json) {
-      const auto &deserializer = _deserializerMap.at(EntityType::Point);
-      auto entity = deserializer->deserializeEntity(json, scene);
+      auto entity = point_deserializer->deserializeEntity(json, scene);
       scene.addEntity(EntityType::Point, std::move(entity));
     }
 
@@ -74,10 +77,15 @@ private:
                              std::make_unique<BezierSurfaceC2Deserializer>()});
   }
 
+  /// reads the whole file first, parsing from memory is much faster than
+  /// from the stream
   json readJson(const std::string &path) const {
-    std::ifstream i(path);
-    json j;
-    i >> j;
-    return j;
+    std::ifstream i(path, std::ios::binary);
+    if (!i) {
+      throw std::runtime_error("Cannot open scene file " + path);
+    }
+    const std::string text{std::istreambuf_iterator<char>(i),
+                           std::istreambuf_iterator<char>()};
+    return json::parse(text);
   }
 };
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/// Collects work that has to run on the thread owning the GL context
+/// (texture uploads, buffer updates). Worker threads push, main thread
+/// processes.
+class MainThreadQueue {
+public:
+  void push(std::function<void()> task) {
+    std::scoped_lock lock(mutex_);
+    tasks_.push_back(std::move(task));
+  }
+
+  void process() {
+    std::vector<std::function<void()>> tasks;
+    {
+      std::scoped_lock lock(mutex_);
+      tasks.swap(tasks_);
+    }
+
+    for (auto &task : tasks) {
+      task();
+    }
+  }
+
+  bool empty() const {
+    std::scoped_lock lock(mutex_);
+    return tasks_.empty();
+  }
+
+private:
+  mutable std::mutex mutex_;
+  std::vector<std::function<void()>> tasks_;
+};
@@ -0,0 +1,218 @@
+#include "pointIndex.hpp"
+#include "IEntity.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace {
+
+float signedDistance(const algebra::Vec4f &plane, const algebra::Vec3f &p) {
+  return plane[0] * p[0] + plane[1] * p[1] + plane[2] * p[2] + plane[3];
+}
+
+bool inside(const std::array<algebra::Vec4f, 6> &frustum,
+            const algebra::Vec3f &p) {
+  return std::ranges::all_of(frustum, [&p](const algebra::Vec4f &plane) {
+    return signedDistance(plane, p) >= 0.f;
+  });
+}
+
+/// false when the box lies entirely behind one of the planes
+bool intersects(const std::array<algebra::Vec4f, 6> &frustum,
+                const algebra::Vec3f &min, const algebra::Vec3f &max) {
+  return std::ranges::all_of(frustum, [&](const algebra::Vec4f &plane) {
+    const algebra::Vec3f furthest(plane[0] >= 0.f ? max[0] : min[0],
+                                  plane[1] >= 0.f ? max[1] : min[1],
+                                  plane[2] >= 0.f ? max[2] : min[2]);
+    return signedDistance(plane, furthest) >= 0.f;
+  });
+}
+
+} // namespace
+
+template <typename Visit>
+void PointIndex::visitInside(const Frustum &frustum, Visit visit) const {
+  if (nodes_.empty()) {
+    return;
+  }
+
+  std::array<uint32_t, 64> stack{};
+  size_t size = 0;
+  stack[size++] = 0;
+
+  while (size > 0) {
+    const auto &node = nodes_[stack[--size]];
+    if (!intersects(frustum, node.min, node.max)) {
+      continue;
+    }
+
+    if (node.count > 0) {
+      for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+        if (inside(frustum, positions_[i])) {
+          visit(i);
+        }
+      }
+      continue;
+    }
+
+    const auto left = static_cast<uint32_t>(&node - nodes_.data()) + 1;
+    stack[size++] = node.right;
+    stack[size++] = left;
+  }
+}
+
+void PointIndex::update(const std::vector<IEntity *> &entities) {
+  if (entities != source_) {
+    source_ = entities;
+    build();
+  } else if (positionsVersion_ != IEntity::positionsVersion()) {
+    refit();
+  }
+}
+
+void PointIndex::queryRect(const algebra::Mat4f &viewProjection,
+                           const algebra::Vec2f &ndcMin,
+                           const algebra::Vec2f &ndcMax,
+                           std::vector<IEntity *> &result) const {
+  visitInside(frustum(viewProjection, ndcMin, ndcMax),
+              [&](uint32_t i) { result.push_back(entities_[i]); });
+}
+
+IEntity *PointIndex::pickNearest(const algebra::Mat4f &viewProjection,
+                                 const algebra::Vec2f &ndcMin,
+                                 const algebra::Vec2f &ndcMax) const {
+  const auto &w_row = viewProjection[3];
+  IEntity *nearest = nullptr;
+  float nearest_depth = std::numeric_limits<float>::max();
+
+  visitInside(frustum(viewProjection, ndcMin, ndcMax), [&](uint32_t i) {
+    const auto &p = positions_[i];
+    const float depth =
+        w_row[0] * p[0] + w_row[1] * p[1] + w_row[2] * p[2] + w_row[3];
+    if (depth < nearest_depth) {
+      nearest_depth = depth;
+      nearest = entities_[i];
+    }
+  });
+  return nearest;
+}
+
+void PointIndex::build() {
+  PROFILE_SCOPE("PointIndex::build");
+  entities_ = source_;
+  positionsVersion_ = IEntity::positionsVersion();
+  positions_.resize(entities_.size());
+  nodes_.clear();
+  if (entities_.empty()) {
+    return;
+  }
+
+  std::vector<uint32_t> order(entities_.size());
+  for (uint32_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+    positions_[i] = entities_[i]->getPosition();
+  }
+  nodes_.reserve(2 * entities_.size() / kLeafSize + 1);
+  buildNode(order, 0, static_cast<uint32_t>(order.size()));
+
+  /// leaves address contiguous ranges, so store entities in leaf order
+  std::vector<IEntity *> entities(entities_.size());
+  std::vector<algebra::Vec3f> positions(positions_.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    entities[i] = entities_[order[i]];
+    positions[i] = positions_[order[i]];
+  }
+  entities_ = std::move(entities);
+  positions_ = std::move(positions);
+}
+
+uint32_t PointIndex::buildNode(std::vector<uint32_t> &order, uint32_t first,
+                               uint32_t count) {
+  const auto index = static_cast<uint32_t>(nodes_.size());
+  nodes_.emplace_back();
+
+  Node node;
+  node.min = node.max = positions_[order[first]];
+  for (uint32_t i = first + 1; i < first + count; ++i) {
+    grow(node, positions_[order[i]]);
+  }
+
+  if (count <= kLeafSize) {
+    node.first = first;
+    node.count = count;
+    nodes_[index] = node;
+    return index;
+  }
+
+  const auto extent = node.max - node.min;
+  size_t axis = extent[0] > extent[1] ? 0 : 1;
+  axis = extent[2] > extent[axis] ? 2 : axis;
+
+  const uint32_t middle = first + count / 2;
+  std::nth_element(order.begin() + first, order.begin() + middle,
+                   order.begin() + first + count,
+                   [this, axis](uint32_t a, uint32_t b) {
+                     return positions_[a][axis] < positions_[b][axis];
+                   });
+
+  buildNode(order, first, middle - first);
+  node.right = buildNode(order, middle, first + count - middle);
+  nodes_[index] = node;
+  return index;
+}
+
+void PointIndex::refit() {
+  PROFILE_SCOPE("PointIndex::refit");
+  positionsVersion_ = IEntity::positionsVersion();
+  for (size_t i = 0; i < entities_.size(); ++i) {
+    positions_[i] = entities_[i]->getPosition();
+  }
+
+  /// children always come after their parent
+  for (size_t i = nodes_.size(); i-- > 0;) {
+    auto &node = nodes_[i];
+    if (node.count > 0) {
+      node.min = node.max = positions_[node.first];
+      for (uint32_t j = node.first + 1; j < node.first + node.count; ++j) {
+        grow(node, positions_[j]);
+      }
+      continue;
+    }
+
+    const auto &left = nodes_[i + 1];
+    const auto &right = nodes_[node.right];
+    node.min = left.min;
+    node.max = left.max;
+    grow(node, right.min);
+    grow(node, right.max);
+  }
+}
+
+void PointIndex::grow(Node &node, const algebra::Vec3f &p) {
+  for (size_t axis = 0; axis < 3; ++axis) {
+    node.min[axis] = std::min(node.min[axis], p[axis]);
+    node.max[axis] = std::max(node.max[axis], p[axis]);
+  }
+}
+
+PointIndex::Frustum PointIndex::frustum(const algebra::Mat4f &viewProjection,
+                                        const algebra::Vec2f &ndcMin,
+                                        const algebra::Vec2f &ndcMax) {
+  /// clip space bounds like ndcMin.x * w <= x become planes over world
+  /// positions by combining rows of the matrix
+  const auto row = [&viewProjection](size_t i) {
+    const auto &r = viewProjection[i];
+    return algebra::Vec4f(r[0], r[1], r[2], r[3]);
+  };
+  const auto x = row(0);
+  const auto y = row(1);
+  const auto z = row(2);
+  const auto w = row(3);
+
+  return {x - w * ndcMin[0], w * ndcMax[0] - x, y - w * ndcMin[1],
+          w * ndcMax[1] - y, z + w,             w - z};
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "IEntity.hpp"
+#include "matrix.hpp"
+#include "vec.hpp"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/// Bounding volume hierarchy over entity positions, used to select points on
+/// the CPU. Rebuilt when the indexed entities change and refitted when they
+/// only moved, so repeated queries cost O(log n + hits).
+class PointIndex {
+public:
+  /// cheap when nothing changed since the last call
+  void update(const std::vector<IEntity *> &entities);
+
+  /// Entities whose position projects into the [ndcMin, ndcMax] rectangle in
+  /// front of the camera, appended to result.
+  void queryRect(const algebra::Mat4f &viewProjection,
+                 const algebra::Vec2f &ndcMin, const algebra::Vec2f &ndcMax,
+                 std::vector<IEntity *> &result) const;
+
+  /// the entity closest to the camera inside the rectangle
+  IEntity *pickNearest(const algebra::Mat4f &viewProjection,
+                       const algebra::Vec2f &ndcMin,
+                       const algebra::Vec2f &ndcMax) const;
+
+private:
+  static constexpr uint32_t kLeafSize = 8;
+
+  /// children of an inner node are the next node and `right`
+  struct Node {
+    algebra::Vec3f min;
+    algebra::Vec3f max;
+    uint32_t first = 0;
+    uint32_t count = 0;
+    uint32_t right = 0;
+  };
+  using Frustum = std::array<algebra::Vec4f, 6>;
+
+  std::vector<IEntity *> source_;
+  /// entities and their positions in leaf order
+  std::vector<IEntity *> entities_;
+  std::vector<algebra::Vec3f> positions_;
+  std::vector<Node> nodes_;
+  uint64_t positionsVersion_ = 0;
+
+  void build();
+  uint32_t buildNode(std::vector<uint32_t> &order, uint32_t first,
+                     uint32_t count);
+  void refit();
+  static void grow(Node &node, const algebra::Vec3f &p);
+
+  static Frustum frustum(const algebra::Mat4f &viewProjection,
+                         const algebra::Vec2f &ndcMin,
+                         const algebra::Vec2f &ndcMax);
+
+  /// calls visit(index into entities_) for every position inside frustum
+  template <typename Visit>
+  void visitInside(const Frustum &frustum, Visit visit) const;
+};
@@ -0,0 +1,146 @@
+#include "profiler.hpp"
+#include "nlohmann/json.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+thread_local uint32_t scope_depth = 0;
+} // namespace
+
+Profiler &Profiler::instance() {
+  static Profiler profiler;
+  return profiler;
+}
+
+int64_t Profiler::now() const {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - start_)
+      .count();
+}
+
+Profiler::RingHandle::~RingHandle() {
+  if (ring_) {
+    Profiler::instance().release(ring_);
+  }
+}
+
+Profiler::Ring &Profiler::threadRing() {
+  thread_local RingHandle handle;
+  if (handle.ring_) {
+    return *handle.ring_;
+  }
+
+  std::scoped_lock lock(mutex_);
+  const auto free_ring = std::ranges::find_if(
+      rings_, [](const auto &ring) { return !ring->active_; });
+  if (free_ring != rings_.end()) {
+    handle.ring_ = *free_ring;
+    /// name and events of the previous thread do not belong to this one
+    std::scoped_lock ring_lock(handle.ring_->mutex_);
+    handle.ring_->name_ = "thread " + std::to_string(handle.ring_->id_);
+    handle.ring_->written_ = 0;
+  } else {
+    handle.ring_ = rings_.emplace_back(std::make_shared<Ring>());
+    handle.ring_->id_ = static_cast<uint32_t>(rings_.size() - 1);
+    handle.ring_->name_ = "thread " + std::to_string(handle.ring_->id_);
+    handle.ring_->events_.resize(kRingCapacity);
+  }
+  handle.ring_->active_ = true;
+  return *handle.ring_;
+}
+
+void Profiler::release(const std::shared_ptr<Ring> &ring) {
+  std::scoped_lock lock(mutex_);
+  ring->active_ = false;
+}
+
+void Profiler::record(const Event &event) {
+  auto &ring = threadRing();
+  std::scoped_lock lock(ring.mutex_);
+  ring.events_[ring.written_++ % kRingCapacity] = event;
+}
+
+void Profiler::setThreadName(std::string name) {
+  auto &ring = threadRing();
+  std::scoped_lock lock(ring.mutex_);
+  ring.name_ = std::move(name);
+}
+
+std::vector<Profiler::Thread> Profiler::snapshot() const {
+  std::vector<std::shared_ptr<Ring>> rings;
+  {
+    std::scoped_lock lock(mutex_);
+    rings = rings_;
+  }
+
+  std::vector<Thread> threads;
+  threads.reserve(rings.size());
+  for (const auto &ring : rings) {
+    std::scoped_lock lock(ring->mutex_);
+    Thread thread{.id_ = ring->id_, .name_ = ring->name_, .events_ = {}};
+
+    const auto count = std::min<uint64_t>(ring->written_, kRingCapacity);
+    thread.events_.reserve(count);
+    for (auto i = ring->written_ - count; i < ring->written_; ++i) {
+      thread.events_.push_back(ring->events_[i % kRingCapacity]);
+    }
+    threads.push_back(std::move(thread));
+  }
+  return threads;
+}
+
+void Profiler::clear() {
+  std::scoped_lock lock(mutex_);
+  for (const auto &ring : rings_) {
+    std::scoped_lock ring_lock(ring->mutex_);
+    ring->written_ = 0;
+  }
+}
+
+/// chrome://tracing and ui.perfetto.dev read this format
+void Profiler::writeChromeTrace(const std::filesystem::path &path) const {
+  auto events = nlohmann::json::array();
+  for (const auto &thread : snapshot()) {
+    events.push_back({{"name", "thread_name"},
+                      {"ph", "M"},
+                      {"pid", 0},
+                      {"tid", thread.id_},
+                      {"args", {{"name", thread.name_}}}});
+    for (const auto &event : thread.events_) {
+      events.push_back({{"name", event.name_},
+                        {"ph", "X"},
+                        {"pid", 0},
+                        {"tid", thread.id_},
+                        {"ts", static_cast<double>(event.start_) / 1000.0},
+                        {"dur", static_cast<double>(event.end_ - event.start_) /
+                                    1000.0}});
+    }
+  }
+
+  std::ofstream out(path);
+  if (!out) {
+    throw std::runtime_error("Failed to open file: " + path.string());
+  }
+  out << nlohmann::json{{"traceEvents", events}};
+}
+
+ProfileScope::ProfileScope(const char *name)
+    : name_(name), start_(Profiler::instance().now()),
+      depth_(scope_depth++) {}
+
+ProfileScope::~ProfileScope() {
+  --scope_depth;
+  auto &profiler = Profiler::instance();
+  profiler.record(Profiler::Event{.name_ = name_,
+                                  .start_ = start_,
+                                  .end_ = profiler.now(),
+                                  .depth_ = depth_});
+}
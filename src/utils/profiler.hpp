@@ -0,0 +1,100 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/// Debug builds always profile, release builds only with ARMCADILLO_PROFILE.
+#if defined(ARMCADILLO_PROFILE) || !defined(NDEBUG)
+#define ARMCADILLO_PROFILING 1
+#else
+#define ARMCADILLO_PROFILING 0
+#endif
+
+/// Scope timings kept per thread in fixed size rings, the oldest events are
+/// overwritten. Names are not copied, pass literals or strings that outlive
+/// the recorded events.
+class Profiler {
+public:
+  /// nanoseconds since the profiler started
+  struct Event {
+    const char *name_;
+    int64_t start_;
+    int64_t end_;
+    uint32_t depth_;
+  };
+
+  struct Thread {
+    uint32_t id_;
+    std::string name_;
+    std::vector<Event> events_;
+  };
+
+  static Profiler &instance();
+
+  int64_t now() const;
+  void record(const Event &event);
+  /// label of the calling thread in the timeline and in traces
+  void setThreadName(std::string name);
+
+  /// events of every thread ordered by end time
+  std::vector<Thread> snapshot() const;
+  void clear();
+  void writeChromeTrace(const std::filesystem::path &path) const;
+
+private:
+  /// rings of finished threads are handed to new ones, std::async spawns a
+  /// thread per task and the ring count would grow without bound
+  struct Ring {
+    mutable std::mutex mutex_;
+    uint32_t id_ = 0;
+    std::string name_;
+    std::vector<Event> events_;
+    uint64_t written_ = 0;
+    bool active_ = false;
+  };
+
+  struct RingHandle {
+    std::shared_ptr<Ring> ring_;
+    ~RingHandle();
+  };
+
+  static constexpr std::size_t kRingCapacity = 1 << 14;
+
+  const std::chrono::steady_clock::time_point start_ =
+      std::chrono::steady_clock::now();
+  mutable std::mutex mutex_;
+  std::vector<std::shared_ptr<Ring>> rings_;
+
+  Profiler() = default;
+  Ring &threadRing();
+  void release(const std::shared_ptr<Ring> &ring);
+};
+
+class ProfileScope {
+public:
+  explicit ProfileScope(const char *name);
+  ~ProfileScope();
+
+  ProfileScope(const ProfileScope &) = delete;
+  ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+  const char *name_;
+  int64_t start_;
+  uint32_t depth_;
+};
+
+#if ARMCADILLO_PROFILING
+#define ARMCADILLO_PROFILE_CONCAT_(a, b) a##b
+#define ARMCADILLO_PROFILE_CONCAT(a, b) ARMCADILLO_PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(name)                                                    \
+  const ProfileScope ARMCADILLO_PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+#else
+#define PROFILE_SCOPE(name) static_cast<void>(0)
+#endif
@@ -0,0 +1,272 @@
+#include "sceneHistory.hpp"
+#include "IEntity.hpp"
+#include "IGroupedEntity.hpp"
+#include "bezierSurface.hpp"
+#include "binaryScene.hpp"
+#include "entitiesTypes.hpp"
+#include "pointEntity.hpp"
+#include "profiler.hpp"
+#include "scene.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+template <typename T>
+void appendChunks(std::vector<std::byte> &buffer, const SharedArray<T> &array) {
+  array.forEachChunk([&buffer](std::span<const T> chunk) {
+    const auto bytes = std::as_bytes(chunk);
+    buffer.insert(buffer.end(), bytes.begin(), bytes.end());
+  });
+}
+
+bool sameValues(const algebra::Vec3f &a, const std::array<float, 3> &b) {
+  return a[0] == b[0] && a[1] == b[1] && a[2] == b[2];
+}
+
+} // namespace
+
+SceneSnapshot::SceneSnapshot(const Scene &scene,
+                             const SceneSnapshot *previous) {
+  PROFILE_SCOPE("SceneSnapshot::capture");
+  const auto contents = BinaryScene::capture(scene);
+  if (previous == nullptr) {
+    points_ = {contents.points, {}};
+    entities_ = {contents.entities, {}};
+    indices_ = {contents.indices, {}};
+    names_ = {contents.names, {}};
+    return;
+  }
+
+  points_ = {contents.points, previous->points_};
+  entities_ = {contents.entities, previous->entities_};
+  indices_ = {contents.indices, previous->indices_};
+  names_ = {contents.names, previous->names_};
+}
+
+bool SceneSnapshot::sameAs(const SceneSnapshot &other) const {
+  return points_.sharesAll(other.points_) &&
+         entities_.sharesAll(other.entities_) &&
+         indices_.sharesAll(other.indices_) && names_.sharesAll(other.names_);
+}
+
+/// Entities whose control points changed are rebuilt rather than patched,
+/// so a record is the single description of what the entity looks like.
+void SceneSnapshot::restore(Scene &scene) const {
+  PROFILE_SCOPE("SceneSnapshot::restore");
+  using Kind = BinaryScene::Kind;
+  const auto points = points_.values();
+  const auto entities = entities_.values();
+  const auto indices = indices_.values();
+  const auto names = names_.values();
+  const auto name = [&names](const BinaryScene::NameRef &ref) {
+    return std::string_view(names.data() + ref.offset, ref.length);
+  };
+
+  std::unordered_set<uint32_t> point_ids;
+  point_ids.reserve(points.size());
+  for (const auto &record : points) {
+    point_ids.insert(record.id);
+  }
+  std::array<std::unordered_map<uint32_t, const BinaryScene::EntityRecord *>,
+             kEntityTypeCount>
+      records;
+  for (const auto &record : entities) {
+    records[static_cast<size_t>(BinaryScene::entityType(record.kind))]
+        .emplace(record.id, &record);
+  }
+
+  const auto same_points = [&](const IGroupedEntity &grouped,
+                               const BinaryScene::EntityRecord &record) {
+    const auto live = grouped.getPointsReferences();
+    if (live.size() != record.indexCount) {
+      return false;
+    }
+    for (size_t i = 0; i < live.size(); ++i) {
+      if (live[i].get().getId() != points[indices[record.firstIndex + i]].id) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  /// Points missing from the snapshot go, and so does every entity missing
+  /// from it or built on other points. Removing a surface takes its points
+  /// along, which in turn takes the curves using them until nothing changes.
+  std::unordered_set<const IEntity *> doomed;
+  for (const auto *point : scene.getEntities(EntityType::Point)) {
+    if (!point_ids.contains(point->getId())) {
+      doomed.insert(point);
+    }
+  }
+  const std::array<Kind, 6> kinds{Kind::Torus,
+                                  Kind::BezierCurveC0,
+                                  Kind::BSplineCurve,
+                                  Kind::InterpolatingSpline,
+                                  Kind::BezierSurfaceC0,
+                                  Kind::BezierSurfaceC2};
+  for (bool changed = true; changed;) {
+    changed = false;
+    for (const auto kind : kinds) {
+      const auto type = BinaryScene::entityType(kind);
+      const auto &recorded = records[static_cast<size_t>(type)];
+      for (const auto *entity : scene.getEntities(type)) {
+        if (doomed.contains(entity)) {
+          continue;
+        }
+        const auto it = recorded.find(entity->getId());
+        const auto *grouped = dynamic_cast<const IGroupedEntity *>(entity);
+        const bool stale =
+            it == recorded.end() ||
+            (grouped != nullptr &&
+             (!same_points(*grouped, *it->second) ||
+              std::ranges::any_of(grouped->getPointsReferences(),
+                                  [&doomed](const auto &point) {
+                                    return doomed.contains(&point.get());
+                                  })));
+        if (!stale) {
+          continue;
+        }
+        doomed.insert(entity);
+        if (const auto *surface = dynamic_cast<const BezierSurface *>(entity)) {
+          for (const auto &point : surface->getPoints()) {
+            doomed.insert(&point.get());
+          }
+        }
+        changed = true;
+      }
+    }
+  }
+  std::vector<const IEntity *> removed(doomed.begin(), doomed.end());
+  scene.removeEntities(removed);
+
+  std::vector<std::reference_wrapper<PointEntity>> scene_points;
+  scene_points.reserve(points.size());
+  for (const auto &record : points) {
+    const auto &p = record.position;
+    auto *point = static_cast<PointEntity *>(
+        scene.findById(EntityType::Point, record.id));
+    if (point == nullptr) {
+      auto created = std::make_unique<PointEntity>(
+          algebra::Vec3f(p[0], p[1], p[2]));
+      created->setId(record.id);
+      created->getName() = name(record.name);
+      point = created.get();
+      scene.addEntity(EntityType::Point, std::move(created));
+    } else if (!sameValues(point->getPosition(), p)) {
+      point->updatePosition(algebra::Vec3f(p[0], p[1], p[2]));
+    }
+    scene_points.emplace_back(*point);
+  }
+
+  std::vector<std::reference_wrapper<PointEntity>> control_points;
+  for (const auto &record : entities) {
+    const auto type = BinaryScene::entityType(record.kind);
+    auto *entity = scene.findById(type, record.id);
+    if (entity == nullptr) {
+      control_points.clear();
+      for (size_t i = 0; i < record.indexCount; ++i) {
+        control_points.push_back(
+            scene_points[indices[record.firstIndex + i]]);
+      }
+      scene.addEntity(type, BinaryScene::makeEntity(
+                                record, name(record.name), control_points));
+      continue;
+    }
+    if (record.kind != Kind::Torus) {
+      continue;
+    }
+    const auto &p = record.position;
+    const auto &r = record.rotation;
+    const auto &s = record.scale;
+    entity->updatePosition(algebra::Vec3f(p[0], p[1], p[2]));
+    entity->getRotation() = algebra::Quaternion<float>(r[3], r[0], r[1], r[2]);
+    entity->getScale() = algebra::Vec3f(s[0], s[1], s[2]);
+  }
+}
+
+void SceneSnapshot::save(const std::string &path) const {
+  PROFILE_SCOPE("SceneSnapshot::save");
+  BinaryScene::Header header;
+  header.pointCount = static_cast<uint32_t>(points_.size());
+  header.entityCount = static_cast<uint32_t>(entities_.size());
+  header.indexCount = static_cast<uint32_t>(indices_.size());
+  header.nameBytes = static_cast<uint32_t>(names_.size());
+
+  std::vector<std::byte> buffer;
+  buffer.reserve(sizeof(header) +
+                 points_.size() * sizeof(BinaryScene::PointRecord) +
+                 entities_.size() * sizeof(BinaryScene::EntityRecord) +
+                 indices_.size() * sizeof(uint32_t) + names_.size());
+  const auto header_bytes =
+      std::as_bytes(std::span<const BinaryScene::Header>(&header, 1));
+  buffer.insert(buffer.end(), header_bytes.begin(), header_bytes.end());
+  appendChunks(buffer, points_);
+  appendChunks(buffer, entities_);
+  appendChunks(buffer, indices_);
+  appendChunks(buffer, names_);
+  BinaryScene::writeFile(path, buffer);
+}
+
+bool SceneHistory::update(const Scene &scene, bool editing) {
+  if (editing || !changedSinceSeen(scene)) {
+    return false;
+  }
+  markSeen(scene);
+
+  const auto *previous = current().get();
+  auto snapshot = std::make_shared<const SceneSnapshot>(scene, previous);
+  if (previous != nullptr && snapshot->sameAs(*previous)) {
+    return false;
+  }
+
+  /// a new edit discards the steps that were undone
+  if (!steps_.empty()) {
+    steps_.resize(current_ + 1);
+  }
+  steps_.push_back(std::move(snapshot));
+  if (steps_.size() > kMaxSteps) {
+    steps_.pop_front();
+  }
+  current_ = steps_.size() - 1;
+  return true;
+}
+
+void SceneHistory::undo(Scene &scene) {
+  if (!canUndo()) {
+    return;
+  }
+  steps_[--current_]->restore(scene);
+  markSeen(scene);
+}
+
+void SceneHistory::redo(Scene &scene) {
+  if (!canRedo()) {
+    return;
+  }
+  steps_[++current_]->restore(scene);
+  markSeen(scene);
+}
+
+std::shared_ptr<const SceneSnapshot> SceneHistory::current() const {
+  return steps_.empty() ? nullptr : steps_[current_];
+}
+
+bool SceneHistory::changedSinceSeen(const Scene &scene) const {
+  return positionsVersion_ != IEntity::positionsVersion() ||
+         sceneRevision_ != scene.revision();
+}
+
+void SceneHistory::markSeen(const Scene &scene) {
+  positionsVersion_ = IEntity::positionsVersion();
+  sceneRevision_ = scene.revision();
+}
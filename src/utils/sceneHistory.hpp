@@ -0,0 +1,123 @@
+#pragma once
+
+#include "binaryScene.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+class Scene;
+
+/// Array split into fixed size chunks shared between copies. One built from
+/// a previous copy allocates only the chunks whose values changed.
+template <typename T> class SharedArray {
+  static_assert(std::is_trivially_copyable_v<T>);
+
+public:
+  static constexpr size_t kChunkSize = 256;
+
+  SharedArray() = default;
+  SharedArray(std::span<const T> values, const SharedArray &previous) {
+    size_ = values.size();
+    chunks_.reserve((size_ + kChunkSize - 1) / kChunkSize);
+    for (size_t first = 0; first < size_; first += kChunkSize) {
+      const auto chunk = values.subspan(first, std::min(kChunkSize,
+                                                        size_ - first));
+      const auto index = chunks_.size();
+      if (index < previous.chunks_.size() &&
+          previous.chunks_[index]->size() == chunk.size() &&
+          std::memcmp(previous.chunks_[index]->data(), chunk.data(),
+                      chunk.size_bytes()) == 0) {
+        chunks_.push_back(previous.chunks_[index]);
+      } else {
+        chunks_.push_back(std::make_shared<const std::vector<T>>(
+            chunk.begin(), chunk.end()));
+      }
+    }
+  }
+
+  size_t size() const { return size_; }
+  /// true when both hold the very same chunks
+  bool sharesAll(const SharedArray &other) const {
+    return chunks_ == other.chunks_;
+  }
+
+  std::vector<T> values() const {
+    std::vector<T> values;
+    values.reserve(size_);
+    forEachChunk([&values](std::span<const T> chunk) {
+      values.insert(values.end(), chunk.begin(), chunk.end());
+    });
+    return values;
+  }
+
+  template <typename Visit> void forEachChunk(Visit visit) const {
+    for (const auto &chunk : chunks_) {
+      visit(std::span<const T>(*chunk));
+    }
+  }
+
+private:
+  std::vector<std::shared_ptr<const std::vector<T>>> chunks_;
+  size_t size_ = 0;
+};
+
+/// Immutable copy of the scene contents in the binary scene layout, safe to
+/// hand to other threads.
+class SceneSnapshot {
+public:
+  /// shares every chunk that did not change since previous
+  SceneSnapshot(const Scene &scene, const SceneSnapshot *previous);
+
+  bool sameAs(const SceneSnapshot &other) const;
+  /// Brings the scene back to the snapshot. Entities added since are
+  /// removed, removed ones are rebuilt from their records under their old
+  /// ids, and points and tori move back to their recorded transforms.
+  /// Gregory surfaces and intersection curves are not recorded, so they are
+  /// neither brought back nor removed.
+  void restore(Scene &scene) const;
+  /// writes the snapshot as a binary scene file
+  void save(const std::string &path) const;
+
+private:
+  SharedArray<BinaryScene::PointRecord> points_;
+  SharedArray<BinaryScene::EntityRecord> entities_;
+  SharedArray<uint32_t> indices_;
+  SharedArray<char> names_;
+};
+
+/// Undo and redo over scene snapshots. A change becomes a step once the edit
+/// making it is finished, consecutive steps share what they did not change.
+class SceneHistory {
+public:
+  /// oldest steps are dropped beyond this, bounding memory
+  static constexpr size_t kMaxSteps = 100;
+
+  /// Records a step when the scene changed since the last one, call once
+  /// per frame. Nothing is recorded while editing, so a drag is one step.
+  /// Returns whether a step was recorded.
+  bool update(const Scene &scene, bool editing);
+
+  bool canUndo() const { return current_ > 0; }
+  bool canRedo() const { return current_ + 1 < steps_.size(); }
+  void undo(Scene &scene);
+  void redo(Scene &scene);
+
+  /// the step the scene is at, nullptr before the first update
+  std::shared_ptr<const SceneSnapshot> current() const;
+
+private:
+  std::deque<std::shared_ptr<const SceneSnapshot>> steps_;
+  size_t current_ = 0;
+  uint64_t positionsVersion_ = std::numeric_limits<uint64_t>::max();
+  uint64_t sceneRevision_ = std::numeric_limits<uint64_t>::max();
+
+  bool changedSinceSeen(const Scene &scene) const;
+  void markSeen(const Scene &scene);
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+/// Values stored contiguously with handles that stay valid until their own
+/// value is erased. Erasing swaps the last value into the hole, so the dense
+/// order is not stable, a stale handle is told apart by its generation.
+template <typename T> class SlotMap {
+public:
+  struct Handle {
+    uint32_t index = std::numeric_limits<uint32_t>::max();
+    uint32_t generation = 0;
+
+    bool operator==(const Handle &) const = default;
+  };
+
+  Handle insert(T value) {
+    uint32_t slot_index = 0;
+    if (freeSlots_.empty()) {
+      slot_index = static_cast<uint32_t>(slots_.size());
+      slots_.emplace_back();
+    } else {
+      slot_index = freeSlots_.back();
+      freeSlots_.pop_back();
+    }
+
+    auto &slot = slots_[slot_index];
+    slot.dense = static_cast<uint32_t>(values_.size());
+    values_.push_back(std::move(value));
+    denseToSlot_.push_back(slot_index);
+    return {slot_index, slot.generation};
+  }
+
+  bool contains(Handle handle) const {
+    return handle.index < slots_.size() &&
+           slots_[handle.index].generation == handle.generation &&
+           slots_[handle.index].dense != kFree;
+  }
+
+  T *get(Handle handle) {
+    return contains(handle) ? &values_[slots_[handle.index].dense] : nullptr;
+  }
+  const T *get(Handle handle) const {
+    return contains(handle) ? &values_[slots_[handle.index].dense] : nullptr;
+  }
+
+  /// dense position of a live handle
+  size_t indexOf(Handle handle) const { return slots_[handle.index].dense; }
+
+  /// Returns the dense position that was vacated, the last value now lives
+  /// there. Containers kept parallel to values() repeat the same swap.
+  size_t erase(Handle handle) {
+    auto &slot = slots_[handle.index];
+    const size_t hole = slot.dense;
+    const size_t last = values_.size() - 1;
+
+    if (hole != last) {
+      values_[hole] = std::move(values_[last]);
+      denseToSlot_[hole] = denseToSlot_[last];
+      slots_[denseToSlot_[hole]].dense = static_cast<uint32_t>(hole);
+    }
+    values_.pop_back();
+    denseToSlot_.pop_back();
+
+    slot.dense = kFree;
+    ++slot.generation;
+    freeSlots_.push_back(handle.index);
+    return hole;
+  }
+
+  const std::vector<T> &values() const { return values_; }
+  size_t size() const { return values_.size(); }
+  bool empty() const { return values_.empty(); }
+
+private:
+  static constexpr uint32_t kFree = std::numeric_limits<uint32_t>::max();
+
+  struct Slot {
+    uint32_t dense = kFree;
+    uint32_t generation = 0;
+  };
+
+  std::vector<T> values_;
+  std::vector<uint32_t> denseToSlot_;
+  std::vector<Slot> slots_;
+  std::vector<uint32_t> freeSlots_;
+};
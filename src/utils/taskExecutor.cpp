@@ -0,0 +1,107 @@
+#include "taskExecutor.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <print>
+#include <string>
+#include <thread>
+#include <utility>
+
+void Task::finish(Status status, std::string error) {
+  if (!error.empty()) {
+    std::println(stderr, "{}: {}", name_, error);
+  }
+  {
+    std::scoped_lock lock(mutex_);
+    error_ = std::move(error);
+  }
+  if (status == Status::Done) {
+    context_.report(1.f);
+  }
+  status_ = status;
+}
+
+TaskExecutor::TaskExecutor(unsigned threadCount) {
+  workers_.reserve(threadCount);
+  for (unsigned i = 0; i < threadCount; ++i) {
+    workers_.emplace_back([this, i] {
+      Profiler::instance().setThreadName("task worker " + std::to_string(i));
+      workerLoop();
+    });
+  }
+}
+
+TaskExecutor::~TaskExecutor() {
+  for (const auto &task : tasks_) {
+    task->cancel();
+  }
+  {
+    std::scoped_lock lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+unsigned TaskExecutor::defaultThreadCount() {
+  /// jobs parallelise internally, a couple of workers keep independent jobs
+  /// from queueing behind each other
+  return std::clamp(std::thread::hardware_concurrency() / 4, 1u, 2u);
+}
+
+void TaskExecutor::enqueue(std::function<void()> job) {
+  {
+    std::scoped_lock lock(mutex_);
+    jobs_.push_back(std::move(job));
+  }
+  wake_.notify_one();
+}
+
+void TaskExecutor::workerLoop() {
+  while (true) {
+    std::function<void()> job;
+    {
+      std::unique_lock lock(mutex_);
+      wake_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+      if (jobs_.empty()) {
+        return;
+      }
+      job = std::move(jobs_.front());
+      jobs_.pop_front();
+    }
+    job();
+  }
+}
+
+void TaskExecutor::processCompletions() {
+  completions_.process();
+  std::erase_if(tasks_, [](const auto &task) {
+    const auto status = task->status();
+    return status == Task::Status::Done || status == Task::Status::Cancelled;
+  });
+}
+
+void TaskExecutor::dismiss(const Task *task) {
+  std::erase_if(tasks_, [task](const auto &t) {
+    return t.get() == task && t->finished();
+  });
+}
+
+void TaskExecutor::complete(const std::shared_ptr<Task> &task,
+                            const std::function<void()> &done) {
+  if (task->context().cancelled()) {
+    task->finish(Task::Status::Cancelled);
+    return;
+  }
+  try {
+    done();
+    task->finish(Task::Status::Done);
+  } catch (const std::exception &e) {
+    task->finish(Task::Status::Failed, e.what());
+  }
+}
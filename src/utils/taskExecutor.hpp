@@ -0,0 +1,140 @@
+#pragma once
+
+#include "mainThreadQueue.hpp"
+#include "progress.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// State of a submitted job shared by the worker running it and the GUI
+/// watching it.
+class Task {
+public:
+  enum class Status : uint8_t { Queued, Running, Done, Failed, Cancelled };
+
+  explicit Task(std::string name) : name_(std::move(name)) {}
+
+  const std::string &name() const { return name_; }
+  /// handed to the routines the job calls, they report into it and stop
+  /// with algebra::Cancelled once it gets cancelled
+  algebra::ProgressContext &context() { return context_; }
+  const algebra::ProgressContext &context() const { return context_; }
+  void cancel() { context_.cancel(); }
+
+  Status status() const { return status_.load(); }
+  /// done, failed or cancelled, completions included
+  bool finished() const { return status() >= Status::Done; }
+  std::string error() const {
+    std::scoped_lock lock(mutex_);
+    return error_;
+  }
+
+  /// blocks until the worker part finished, rethrows its error
+  void wait() const { future_.get(); }
+
+private:
+  friend class TaskExecutor;
+
+  std::string name_;
+  algebra::ProgressContext context_;
+  std::atomic<Status> status_ = Status::Queued;
+  mutable std::mutex mutex_;
+  std::string error_;
+  std::shared_future<void> future_;
+
+  void finish(Status status, std::string error = {});
+};
+
+/// Fixed pool of worker threads running submitted jobs in order. A job's
+/// result is handed to its completion on the main thread, so completions may
+/// touch GL and the scene while jobs may not.
+class TaskExecutor {
+public:
+  explicit TaskExecutor(unsigned threadCount = defaultThreadCount());
+  /// cancels pending jobs and waits for running ones
+  ~TaskExecutor();
+
+  TaskExecutor(const TaskExecutor &) = delete;
+  TaskExecutor &operator=(const TaskExecutor &) = delete;
+
+  /// work(Task &) runs on a worker, done(result) on the main thread during
+  /// the next processCompletions(), skipped when the task got cancelled
+  template <typename Work, typename Done>
+  std::shared_ptr<Task> submit(std::string name, Work work, Done done);
+
+  template <typename Work>
+  std::shared_ptr<Task> submit(std::string name, Work work) {
+    return submit(std::move(name), std::move(work), [](auto &&...) {});
+  }
+
+  /// call once per frame on the thread owning the GL context
+  void processCompletions();
+
+  /// unfinished and failed tasks, failed ones stay until dismissed
+  const std::vector<std::shared_ptr<Task>> &tasks() const { return tasks_; }
+  void dismiss(const Task *task);
+
+private:
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::deque<std::function<void()>> jobs_;
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
+
+  MainThreadQueue completions_;
+  std::vector<std::shared_ptr<Task>> tasks_;
+
+  static unsigned defaultThreadCount();
+  void enqueue(std::function<void()> job);
+  void workerLoop();
+  void complete(const std::shared_ptr<Task> &task,
+                const std::function<void()> &done);
+};
+
+template <typename Work, typename Done>
+std::shared_ptr<Task> TaskExecutor::submit(std::string name, Work work,
+                                           Done done) {
+  using Result = std::invoke_result_t<Work &, Task &>;
+
+  auto task = std::make_shared<Task>(std::move(name));
+  auto promise = std::make_shared<std::promise<void>>();
+  task->future_ = promise->get_future().share();
+  tasks_.push_back(task);
+
+  enqueue([this, task, promise, work = std::move(work),
+           done = std::move(done)]() mutable {
+    task->status_ = Task::Status::Running;
+    task->context_.restart();
+    try {
+      task->context_.throwIfCancelled();
+      if constexpr (std::is_void_v<Result>) {
+        work(*task);
+        completions_.push([this, task, done] { complete(task, done); });
+      } else {
+        auto result = std::make_shared<Result>(work(*task));
+        completions_.push([this, task, done, result] {
+          complete(task, [&] { done(std::move(*result)); });
+        });
+      }
+      promise->set_value();
+    } catch (const algebra::Cancelled &) {
+      task->finish(Task::Status::Cancelled);
+      promise->set_value();
+    } catch (const std::exception &e) {
+      task->finish(Task::Status::Failed, e.what());
+      promise->set_exception(std::current_exception());
+    }
+  });
+  return task;
+}